@@ -0,0 +1,209 @@
+/**
+ * \file
+ * Embedded JSON builder and parser - Benchmark synthetic corpus generator
+ * PROJECT: GJSON library
+ * TARGET SYSTEM: Linux
+ */
+
+#ifndef GJSON_BENCH_CORPUS_H
+#define GJSON_BENCH_CORPUS_H
+
+/**
+ * Corpus shapes
+ */
+typedef enum {
+    SHAPE_NUMBER = 0,                       ///< Array of arrays of integer and decimal literals
+    SHAPE_STRING,                           ///< Array of maps with string values, some escaped
+    SHAPE_DEEP,                             ///< Array of items nested 16 maps and arrays deep
+    SHAPE_WIDE,                             ///< Single map of many attribute/properties
+    SHAPE_COUNT                             ///< Number of shapes
+}SHAPE;
+
+
+/**
+ * Corpus shape names, as reported
+ */
+static const char* shape_names[SHAPE_COUNT] = { "number", "string", "deep", "wide" };
+
+
+/**
+ * Words strings are made from
+ */
+static const char* corpus_words[] = { "alpha", "beta", "gamma", "delta", "sensor", "valve", "pump", "idle", "run", "fault",
+                                      "north", "south", "a\"b", "line\n", "tab\t", "x" };
+
+
+/**
+ * Synthetic corpus generator.  Makes JSON strings of a given shape up to a given length using \ref JSONWriter so
+ * every corpus is valid JSON.  Content is pseudo random from a seed, the same seed, shape and length always giving the
+ * same string
+ */
+class Corpus {
+public:
+    /**
+     * Constructor, make stable instance
+     *
+     * \param[in] seed Pseudo random seed, not 0
+     */
+    Corpus(uint32_t seed=0x2545f491UL) : seed_(seed), state_(seed) { }
+
+
+    /**
+     * Generate corpus into I/O
+     *
+     * \param[in,out] io Pointer to I/O instance, destination of JSON string
+     * \param[in] shape Shape of corpus
+     * \param[in] length Target length (characters), string is at most this long excluding NULL terminator
+     * \return Length of JSON string or 0 on failure
+     */
+    uint16_t Generate(gjson::IO* io, const SHAPE shape, const uint16_t length) {
+        gjson::JSONWriter w(io, 3);
+        uint32_t n = 0;
+        char k[12];
+
+        state_ = seed_;
+        if (SHAPE_WIDE == shape) {
+            w.BeginMap();
+        }else {
+            w.BeginArray();
+        }
+        // Each item is less than reserve characters
+        while(gjson::JSONConstant::ERR_NONE == w.GetLastError() && (io->GetLength() + kReserve) < length) {
+            switch(shape) {
+                case SHAPE_NUMBER : {
+                    w.BeginArray();
+                    for(uint8_t i=0; i<8; i++) {
+                        if (Next() & 1) {
+                            w.Value(static_cast<long>(Next() % 200000) - 100000);
+                        }else {
+                            w.Value(static_cast<double>(Next() % 2000000) / 1000.0 - 1000.0);
+                        }
+                    }
+                    w.EndArray();
+                    break;
+                }
+
+                case SHAPE_STRING : {
+                    char s[24];
+
+                    w.BeginMap();
+                    w.Key("name");
+                    w.Value(Words(s, sizeof(s)));
+                    w.Key("tag");
+                    w.Value(Words(s, sizeof(s)));
+                    w.Key("note");
+                    w.Value(Words(s, sizeof(s)));
+                    w.EndMap();
+                    break;
+                }
+
+                case SHAPE_DEEP : {
+                    uint8_t i;
+
+                    for(i=0; i<8; i++) {
+                        w.BeginMap();
+                        w.Key("d");
+                        w.BeginArray();
+                    }
+                    w.Value(static_cast<long>(Next() % 1000));
+                    for(i=0; i<8; i++) {
+                        w.EndArray();
+                        w.EndMap();
+                    }
+                    break;
+                }
+
+                case SHAPE_WIDE : {
+                    Key(k, n);
+                    w.Key(k);
+                    switch(Next() % 3) {
+                        case 0 : w.Value(static_cast<long>(Next() % 100000)); break;
+                        case 1 : w.Value((Next() & 1) ? true : false); break;
+                        default : w.Value(corpus_words[Next() % (sizeof(corpus_words) / sizeof(corpus_words[0]))]); break;
+                    }
+                    break;
+                }
+
+                default : {
+                    break;
+                }
+            } // switch(shape)
+            n++;
+        } // while(...)
+        if (SHAPE_WIDE == shape) {
+            w.EndMap();
+        }else {
+            w.EndArray();
+        }
+
+        return (gjson::JSONConstant::ERR_NONE == w.GetLastError()) ? io->GetLength() - 1 : 0;
+    } // Generate(...)
+
+protected:
+    static const uint16_t kReserve = 192;   ///< Longest item of any shape (characters), with closes
+
+
+    /**
+     * Next pseudo random number, xorshift32
+     *
+     * \return Number
+     */
+    uint32_t Next() {
+        state_ ^= state_ << 13;
+        state_ ^= state_ >> 17;
+        state_ ^= state_ << 5;
+
+        return state_;
+    }
+
+
+    /**
+     * Make string of random words
+     *
+     * \param[out] s Destination string
+     * \param[in] l Destination length (characters, including NULL terminator)
+     * \return Destination string
+     */
+    const char* Words(char* s, const uint8_t l) {
+        uint8_t i = 0, c = 1 + Next() % 3;
+
+        s[0] = '\0';
+        while(c--) {
+            const char* wd = corpus_words[Next() % (sizeof(corpus_words) / sizeof(corpus_words[0]))];
+            uint8_t wl = strlen(wd);
+
+            if (i + wl + 1 >= l) {
+                break;
+            }
+            if (i) {
+                s[i++] = ' ';
+            }
+            memcpy(&s[i], wd, wl + 1);
+            i += wl;
+        }
+
+        return s;
+    } // Words(...)
+
+
+    /**
+     * Make attribute/property string from number, "k" then 5 digits
+     *
+     * \param[out] k Destination string, at least 7 characters
+     * \param[in] n Number
+     */
+    static void Key(char* k, uint32_t n) {
+        k[0] = 'k';
+        for(uint8_t i=5; i>0; i--) {
+            k[i] = static_cast<char>('0' + (n % 10));
+            n /= 10;
+        }
+        k[6] = '\0';
+    }
+
+
+    uint32_t    seed_;                      ///< Pseudo random seed
+    uint32_t    state_;                     ///< Pseudo random state
+}; // class Corpus
+
+#endif // GJSON_BENCH_CORPUS_H
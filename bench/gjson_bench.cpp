@@ -0,0 +1,303 @@
+// gjson_bench.cpp : Benchmark suite, throughput of parsing, writing, searching and classifying over a synthetic corpus.
+//
+// Report is comma separated values, one line per operation, shape and size, lines starting '#' are comments.  Diff
+// reports of two versions, or load them into a spreadsheet.
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#define GJSON_PRINT(s)                      printf("%s", s)
+#define GJSON_PRINTSTR(s)                   printf("%s", s)
+#define GJSON_PRINTLINE(s)                  printf("%s\n", s)
+
+#include "../gjson.h"
+#include "corpus.h"
+
+using namespace gjson;
+
+#define BENCH_LENGTH                        32          // String length of parsers
+#define BENCH_MAX                           65535       // Buffers, parser character indices are 16 bit
+#define BENCH_OBJECT_MAX                    0x1000000UL // Object memory, chains of the largest corpus
+
+
+/**
+ * Parser counting tokens given to callbacks, every array and map open/close, attribute/property and value
+ */
+class TokenCount : public JSONParse<BENCH_LENGTH, TokenCount> {
+    typedef JSONParse<BENCH_LENGTH, TokenCount> Parse;
+    friend class JSONParse<BENCH_LENGTH, TokenCount>;
+
+public:
+    TokenCount(IO* io) : Parse(io), tokens_(0) {
+        Parse::Callbacks(true);
+    }
+
+
+    uint32_t Count(char* s) {
+        tokens_ = 0;
+        Parse::FromString(s);
+
+        return (ERR_NONE == Parse::GetLastError()) ? tokens_ : 0;
+    }
+
+protected:
+    bool TokenArray(const JSONArray<BENCH_LENGTH>* e, char *s=NULL, uint16_t i=0) {
+        tokens_++;
+        return false;
+    }
+
+
+    bool TokenMap(const JSONArray<BENCH_LENGTH>* e, char *s=NULL, uint16_t i=0) {
+        tokens_++;
+        return false;
+    }
+
+
+    bool TokenString(const JSONString<BENCH_LENGTH>* e, char *s=NULL, int16_t si=0, int16_t ei=0) {
+        tokens_++;
+        return false;
+    }
+
+
+    uint32_t    tokens_;
+}; // class TokenCount
+
+
+static char corpus[BENCH_MAX];              // Corpus JSON string
+static char output[BENCH_MAX];              // Destination of output operations
+static char work[BENCH_MAX];                // Copy of corpus for operations given I/O
+static uint64_t min_ns = 200000000ULL;      // Minimum time of each measurement
+
+
+/**
+ * Monotonic time now
+ *
+ * \return Nanoseconds
+ */
+static uint64_t now_ns() {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+
+
+/**
+ * Time an operation, repeating with doubling iterations until the minimum time is reached
+ *
+ * \param[in] op Operation, callable returning error numeric
+ * \param[out] iterations Iterations of final measurement
+ * \param[out] err Error of operation, measurement stops on error
+ * \return Nanoseconds per operation
+ */
+template<class OP>
+static double measure(OP op, uint32_t& iterations, int& err) {
+    uint64_t t = 0;
+
+    iterations = 1;
+    err = op();    // Warm
+    while(!err) {
+        uint64_t s = now_ns();
+
+        for(uint32_t i=0; i<iterations; i++) {
+            err |= op();
+        }
+        t = now_ns() - s;
+        if (t >= min_ns || iterations >= (1UL << 30)) {
+            break;
+        }
+        iterations *= 2;
+    }
+
+    return err ? 0.0 : static_cast<double>(t) / iterations;
+}
+
+
+/**
+ * Print report line
+ *
+ * \param[in] op Operation name
+ * \param[in] shape Corpus shape name
+ * \param[in] size Target corpus size
+ * \param[in] bytes Bytes processed per operation
+ * \param[in] tokens Tokens processed per operation
+ * \param[in] iterations Iterations measured
+ * \param[in] ns Nanoseconds per operation
+ * \param[in] err Error numeric, 0 none
+ */
+static void report(const char* op, const char* shape, uint32_t size, uint32_t bytes, uint32_t tokens, uint32_t iterations, double ns, int err) {
+    double mbs = (ns > 0) ? (bytes * 1000.0) / ns : 0.0;
+    double nst = (tokens && ns > 0) ? ns / tokens : 0.0;
+
+    printf("%s,%s,%lu,%lu,%lu,%lu,%.1f,%.2f,%.2f,%d\n", op, shape, static_cast<unsigned long>(size), static_cast<unsigned long>(bytes),
+           static_cast<unsigned long>(tokens), static_cast<unsigned long>(iterations), ns, mbs, nst, err);
+    fflush(stdout);
+}
+
+
+/**
+ * Benchmark all operations of one corpus
+ *
+ * \param[in] shape Corpus shape
+ * \param[in] size Target corpus size
+ */
+static void bench_corpus(SHAPE shape, uint16_t size) {
+    UserBuffer cio(corpus, sizeof(corpus));
+    Corpus c;
+    uint16_t l = c.Generate(&cio, shape, size);
+    const char* sn = shape_names[shape];
+    uint32_t it, tokens;
+    int err;
+    double ns;
+
+    if (!l) {
+        report("generate", sn, size, 0, 0, 0, 0, 1);
+        return;
+    }
+    {
+        TokenCount tc(&cio);
+
+        tokens = tc.Count(corpus);
+    }
+
+    // Parse only, callbacks given elements
+    {
+        JSONParse<BENCH_LENGTH> pr(&cio, BENCH_OBJECT_MAX);
+
+        ns = measure([&]() -> int { pr.FromString(corpus); return pr.GetLastError(); }, it, err);
+        report("from_string", sn, size, l, tokens, it, ns, err);
+    }
+
+    // Object chain size without parse
+    {
+        JSONParse<BENCH_LENGTH> pr(&cio, BENCH_OBJECT_MAX);
+
+        ns = measure([&]() -> int { pr.Estimate(corpus); return pr.GetLastError(); }, it, err);
+        report("estimate", sn, size, l, tokens, it, ns, err);
+    }
+
+    // Parse to object chain, released each time
+    {
+        JSONParse<BENCH_LENGTH> pr(&cio, BENCH_OBJECT_MAX);
+        JSONElement<BENCH_LENGTH>* h = NULL;
+
+        ns = measure([&]() -> int { pr.FromString(corpus, &h); pr.Release(&h); return pr.GetLastError(); }, it, err);
+        report("from_string_chain", sn, size, l, tokens, it, ns, err);
+    }
+
+    // Object chain operations
+    {
+        UserBuffer oio(output, sizeof(output));
+        JSONParse<BENCH_LENGTH> pr(&oio, BENCH_OBJECT_MAX);
+        JSONElement<BENCH_LENGTH>* h = NULL;
+
+        pr.FromString(corpus, &h);
+        err = pr.GetLastError();
+        if (!err) {
+            ns = measure([&]() -> int { pr.FromObject(h); return pr.GetLastError(); }, it, err);
+            report("from_object", sn, size, oio.GetLength() - 1, tokens, it, ns, err);
+
+            // Absent strings, every element visited
+            ns = measure([&]() -> int { return (NULL != pr.FindString(h, const_cast<char*>("absent value"))) ? 1 : 0; }, it, err);
+            report("find_string", sn, size, l, tokens, it, ns, err);
+            ns = measure([&]() -> int { return (NULL != pr.FindString(h, const_cast<char*>("absent"), false)) ? 1 : 0; }, it, err);
+            report("find_attr", sn, size, l, tokens, it, ns, err);
+        }else {
+            report("from_object", sn, size, 0, tokens, 0, 0, err);
+            report("find_string", sn, size, 0, tokens, 0, 0, err);
+            report("find_attr", sn, size, 0, tokens, 0, 0, err);
+        }
+        pr.Release(&h);
+    }
+
+    // String search and replace of absent attribute/property, every character visited and string unchanged
+    {
+        UserBuffer wio(work, sizeof(work), l);
+        JSONSimpleStringParseAttr<BENCH_LENGTH> pr(&wio);
+
+        memcpy(work, corpus, l + 1);
+        ns = measure([&]() -> int { pr.FromStringSearch(const_cast<char*>("absent")); return (JSONConstant::ERR_NOT_FOUND != pr.GetLastError()); }, it, err);
+        report("from_string_search", sn, size, l, tokens, it, ns, err);
+        ns = measure([&]() -> int { pr.FromStringReplace(const_cast<char*>("absent"), const_cast<char*>("0")); return (JSONConstant::ERR_NOT_FOUND != pr.GetLastError()); }, it, err);
+        report("from_string_replace", sn, size, l, tokens, it, ns, err);
+    }
+} // bench_corpus(...)
+
+
+/**
+ * Benchmark literal classifiers over a fixed set of literals
+ */
+static void bench_classifiers() {
+    static const char* literals[] = { "0", "-1", "12345", "4294967295", "-2147483648", "3.14159", "-0.001", "1e10", "-2.5E-3",
+                                      "6.022e+23", "true", "false", "null", "0x1f", "12a", "--1", "1.2.3", "" };
+    const uint8_t n = sizeof(literals) / sizeof(literals[0]);
+    uint16_t ll[n];
+    uint32_t bytes = 0, it;
+    int err;
+    double ns;
+
+    for(uint8_t i=0; i<n; i++) {
+        ll[i] = strlen(literals[i]);
+        bytes += ll[i];
+    }
+    ns = measure([&]() -> int { uint8_t c = 0; for(uint8_t i=0; i<n; i++) { c += JSONSupport::IsLiteral(literals[i], ll[i]); } return (c > n); }, it, err);
+    report("is_literal", "literals", bytes, bytes, n, it, ns, err);
+    ns = measure([&]() -> int { uint8_t c = 0; for(uint8_t i=0; i<n; i++) { c += JSONSupport::IsInt(literals[i], ll[i]); } return (c > n); }, it, err);
+    report("is_int", "literals", bytes, bytes, n, it, ns, err);
+    ns = measure([&]() -> int { uint8_t c = 0; for(uint8_t i=0; i<n; i++) { c += JSONSupport::IsDecimal(literals[i], ll[i]); } return (c > n); }, it, err);
+    report("is_decimal", "literals", bytes, bytes, n, it, ns, err);
+    ns = measure([&]() -> int { uint8_t c = 0; for(uint8_t i=0; i<n; i++) { c += JSONSupport::IsBoolean(literals[i], ll[i]) + JSONSupport::IsNull(literals[i], ll[i]); } return (c > n); }, it, err);
+    report("is_boolean_null", "literals", bytes, bytes, n, it, ns, err);
+} // bench_classifiers(...)
+
+
+/**
+ * Usage:
+ *   gjson_bench [-t ms] [-s shape]      Run benchmarks, report to stdout
+ *   gjson_bench -c shape size           Write corpus to stdout
+ */
+int main(int argc, char* argv[]) {
+    static const uint16_t sizes[] = { 1024, 4096, 16384, 32000 };
+    int shape = -1;
+
+    for(int a=1; a<argc; a++) {
+        if (!strcmp(argv[a], "-t") && a+1 < argc) {
+            min_ns = strtoul(argv[++a], NULL, 10) * 1000000ULL;
+        }else if (!strcmp(argv[a], "-s") && a+1 < argc) {
+            for(shape=SHAPE_COUNT-1; shape>=0 && strcmp(argv[a+1], shape_names[shape]); shape--);
+            a++;
+        }else if (!strcmp(argv[a], "-c") && a+2 < argc) {
+            UserBuffer cio(corpus, sizeof(corpus));
+            Corpus c;
+
+            for(shape=SHAPE_COUNT-1; shape>=0 && strcmp(argv[a+1], shape_names[shape]); shape--);
+            if (shape < 0 || !c.Generate(&cio, static_cast<SHAPE>(shape), atoi(argv[a+2]))) {
+                fprintf(stderr, "Bad corpus\n");
+                return 1;
+            }
+            printf("%s\n", corpus);
+            return 0;
+        }else {
+            fprintf(stderr, "Usage: %s [-t ms] [-s number|string|deep|wide] | -c shape size\n", argv[0]);
+            return 1;
+        }
+    }
+
+    printf("# gjson_bench 1\n");
+    printf("# string length %d, minimum time %lu ms\n", BENCH_LENGTH, static_cast<unsigned long>(min_ns / 1000000ULL));
+    printf("op,shape,size,bytes,tokens,iterations,ns_op,mb_s,ns_token,error\n");
+    for(int s=0; s<SHAPE_COUNT; s++) {
+        if (shape < 0 || shape == s) {
+            for(uint8_t i=0; i<sizeof(sizes)/sizeof(sizes[0]); i++) {
+                bench_corpus(static_cast<SHAPE>(s), sizes[i]);
+            }
+        }
+    }
+    bench_classifiers();
+
+    return 0;
+}
@@ -1,12 +1,12 @@
 /**
  * Example use of GJSON (embedded portable JSON library) - In this example a JSON object chain on the stack containing a
- * map of attributes which is searched and then the values in the adjacent property array are iterated over.  A global 
- * NULL I/O buffer is used with a JSON parser.
+ * map of attributes is queried by JSONPath for the values in the property array of one attribute, each match given 
+ * in turn.  No parser or I/O buffer is required.
  *
  * Expected serial output (Arduino/Genuino Uno):
  * setup()
  * Find string(s)
- * Attribute string: marmalade
+ * Query: $.marmalade[*]
  * Value string: orange
  * Value string: lemon
  * Value string: lime
@@ -19,10 +19,9 @@
 #include "gjson.h"
 
 /*
- * Global I/O buffer + JSON Parsing and building instance
+ * Global JSONPath query, compiled once
  */
-gjson::NullBuffer njio;               // We arn't creating a JSON string so no buffer
-gjson::JSONParse<12, 0> pr(&njio);    // Maximum 0B object chain can be generated.  Not required for this example
+gjson::JSONPath<12> jp("$.marmalade[*]");    // Any element of array of attribute marmalade
 
 void setup() {
     Serial.begin(9600);
@@ -45,29 +44,20 @@ void setup() {
 
     Serial.println("Find string(s)");
 
-    // Find attribute marmalade
-    auto mm = pr.FindString(&a, "marmalade", false);
-    if (pr.GetLastError() != gjson::JSONConstant::ERR_NONE || NULL==mm) {
-        Serial.print("Last error: ");
-        Serial.print(pr.GetLastError());
-        return;
-    }
-    Serial.print("Attribute string: ");
-    Serial.println(mm->Data());
+    Serial.println("Query: $.marmalade[*]");
 
-    // Iterate over value strings after above find
-    do {
-        auto ns = pr.NextString(mm);
-
-        if (ns) {
+    // Iterate over matched value strings, single pass of object chain
+    for(auto m = jp.Find(&a); m; m = jp.FindNext()) {
+        if (gjson::JSONElement<12>::STRING == m->Type()) {
             Serial.print("Value string: ");
-            Serial.println(ns->Data());
-
-            mm = ns;
-        }else {
-            break;
+            Serial.println(reinterpret_cast<gjson::JSONString<12>*>(m)->Data());
         }
-    }while(1);
+    }
+    if (jp.GetLastError() != gjson::JSONConstant::ERR_NOT_FOUND) {
+        Serial.print("Last error: ");
+        Serial.print(jp.GetLastError());
+        return;
+    }
 
     Serial.println("Done");
 }
@@ -88,6 +88,27 @@ namespace gjson {
 
 #endif // !defined(GJSON_NEW_OBJECT)
 
+#if !defined(GJSON_NEW_ARRAY)
+/**
+ * Macro to allocate new array on heap, storage of packed numbers elements (\ref JSONNumbers).  Define your own with 
+ * accompanying macro \ref GJSON_RELEASE_ARRAY as \ref GJSON_NEW_OBJECT
+ *
+ * \param[in] t Type of array items
+ * \param[in] n Number of items
+ * \return Pointer to array or NULL
+ */
+#define GJSON_NEW_ARRAY(t,n)                (new t[n])
+
+
+/**
+ * Macro to release existing array off heap, see \ref GJSON_NEW_ARRAY
+ *
+ * \param[in] p Array pointer
+ */
+#define GJSON_RELEASE_ARRAY(p)              (delete [] p)
+
+#endif // !defined(GJSON_NEW_ARRAY)
+
 #if !defined(GJSON_DEFAULT_EXPONENTIAL_NOTATION)
 /**
  * Build macro to control default acceptance of exponential notation in JSON literal strings
@@ -99,6 +120,139 @@ namespace gjson {
 #endif // defined(GJSON_DEFAULT_EXPONENTIAL_NOTATION)
 
 
+#if !defined(GJSON_COMPACT_ELEMENTS)
+/**
+ * Build macro to select compact element layout.  Element type and array open, string value and literal flags are 
+ * packed into one header byte and the next element link is a 32 bit offset relative to the element, so on 64 bit 
+ * hosts an array or map element is 8 Bytes rather than 24
+ *
+ * \attention Linked elements must be within 2GB of each other, e.g. from one heap or arena.  Plain new does not 
+ * promise this, some heaps (e.g. sanitizer) keep sizes apart, so give \ref GJSON_NEW_OBJECT one arena.  Links out of 
+ * range are refused, \ref JSONParse::FromString then fails with ERR_OBJECT_MEMORY_LIMIT.  Define before include to 
+ * override, 1 enables
+ */
+#define GJSON_COMPACT_ELEMENTS              0
+#endif // defined(GJSON_COMPACT_ELEMENTS)
+
+
+#if !defined(GJSON_SOURCE_SPANS)
+/**
+ * Build macro to keep source spans of elements.  Each element parsed by \ref JSONParse::FromString remembers the 
+ * character span of its token in the JSON string, 4 Bytes more per element, so \ref JSONParse::FromObjectIncremental 
+ * copies unchanged runs straight from that string.  Changing an element drops its span (dirty)
+ *
+ * \attention Define before include to override, 1 enables
+ */
+#define GJSON_SOURCE_SPANS                  0
+#endif // defined(GJSON_SOURCE_SPANS)
+
+
+#if !defined(GJSON_TEMPLATE_WIDTH)
+/**
+ * Build macro for maximum fixed width in characters of a \ref JSONTemplate value slot, also bounds
+ * formatted values held on stack during render
+ *
+ * \attention Define before include to override
+ */
+#define GJSON_TEMPLATE_WIDTH                24
+#endif // defined(GJSON_TEMPLATE_WIDTH)
+
+
+#if !defined(GJSON_SIMD)
+/**
+ * Build macro to enable SIMD string scanning, SSE2 when target has it.  Otherwise scanning is a machine
+ * word at a time
+ *
+ * \attention Define before include to override, 0 disables
+ */
+#if defined(__SSE2__)
+#define GJSON_SIMD                          1
+#else
+#define GJSON_SIMD                          0
+#endif
+#endif // defined(GJSON_SIMD)
+
+
+#if !defined(GJSON_NOINLINE)
+/**
+ * Build macro to keep a function out of line, so its stack frame is only taken when called.  Used for the
+ * scratch elements of parsing without object chain
+ *
+ * \attention Define before include to override, empty for compilers without such an attribute
+ */
+#if defined(__GNUC__)
+#define GJSON_NOINLINE                      __attribute__((noinline))
+#elif defined(_MSC_VER)
+#define GJSON_NOINLINE                      __declspec(noinline)
+#else
+#define GJSON_NOINLINE
+#endif
+#endif // defined(GJSON_NOINLINE)
+
+
+#if !defined(GJSON_STATS)
+/**
+ * Build macro to enable parser statistics, see \ref JSONParse::GetStats.  When 0 statistics and all counting of them 
+ * are compiled out
+ *
+ * \attention Define before include to override, 1 enables
+ */
+#define GJSON_STATS                         0
+#endif // defined(GJSON_STATS)
+
+
+#if !defined(GJSON_STATS_CLOCK)
+/**
+ * Macro giving free running clock for parser statistics phase times, units are those of clock.  Arduino micros() 
+ * by default, elsewhere 0 (no times) unless defined
+ *
+ * \return Clock count
+ */
+#if defined(ARDUINO)
+#define GJSON_STATS_CLOCK()                 micros()
+#else
+#define GJSON_STATS_CLOCK()                 0
+#endif
+#endif // defined(GJSON_STATS_CLOCK)
+
+
+#if !defined(GJSON_TRACE_BEGIN)
+/**
+ * Macro hook marking start of a parser operation (FromString, FromObject, FindObject or Release).  Define with 
+ * \ref GJSON_TRACE_END and \ref GJSON_TRACE_EVENT to map onto profiler markers, e.g. USDT probes or LTTng 
+ * tracepoints.  Defaults evaluate to nothing so have no cost
+ *
+ * \param[in] op Operation name, string literal
+ * \param[in] size Document size, characters.  0 when not known
+ */
+#define GJSON_TRACE_BEGIN(op, size)         ((void)0)
+#endif // defined(GJSON_TRACE_BEGIN)
+
+
+#if !defined(GJSON_TRACE_END)
+/**
+ * Macro hook marking end of a parser operation, see \ref GJSON_TRACE_BEGIN
+ *
+ * \param[in] op Operation name, string literal
+ * \param[in] size Document size, characters.  For FromObject the output length
+ * \param[in] count Elements parsed, written, visited or released
+ */
+#define GJSON_TRACE_END(op, size, count)    ((void)(count))
+#endif // defined(GJSON_TRACE_END)
+
+
+#if !defined(GJSON_TRACE_EVENT)
+/**
+ * Macro hook marking a callback dispatch, see \ref GJSON_TRACE_BEGIN
+ *
+ * \param[in] op Event name, string literal
+ * \param[in] operation Operation in progress, JSONConstant::OP numeric
+ * \param[in] depth Relative nesting depth of string parse, 0 otherwise
+ */
+#define GJSON_TRACE_EVENT(op, operation, depth) ((void)0)
+#endif // defined(GJSON_TRACE_EVENT)
+
+
 #if !defined(GJSON_REPLACE_STRNCMPI)
 /**
  * Macro string compare case sensitive.  Redirect to library calls if they exist in your build
@@ -135,8 +289,17 @@ namespace gjson {
 #include "gjson_support.h"
 #include "gjson_elements.h"
 #include "gjson_builders.h"
+#include "gjson_pool.h"
 #include "gjson_io_buffer.h"
 #include "gjson_parser.h"
+#include "gjson_pointer.h"
+#include "gjson_lazy.h"
+#include "gjson_path.h"
+#include "gjson_edit.h"
+#include "gjson_writer.h"
+#include "gjson_template.h"
+#include "gjson_bind.h"
+#include "gjson_columns.h"
 
 #if defined(GJSON_PACKING)
 #pragma pack(pop)
@@ -0,0 +1,479 @@
+/**
+ * \file
+ * Embedded JSON builder and parser - Struct binding
+ * PROJECT: GJSON library
+ * TARGET SYSTEM: Arduino, STM32, Atmel AT91SAM, portable
+ */
+
+#ifndef GJSON_BIND_H
+#define GJSON_BIND_H
+
+namespace gjson {
+
+/**
+ * Binding of a struct field to a JSON attribute/property.  Declare a table of these per struct using
+ * \ref GJSON_BIND_FIELD, e.g.
+ *
+ * static const gjson::JSONBindField cmd_fields[] = {
+ *     GJSON_BIND_FIELD(Cmd, value, "value"),
+ *     GJSON_BIND_FIELD(Cmd, name, "name"),
+ * };
+ */
+struct JSONBindField {
+    /**
+     * Enum of bound field types
+     */
+    typedef enum {
+        BOOL,                           /// bool
+        INT,                            /// Signed integer, 1, 2, 4 or 8 Bytes
+        UINT,                           /// Unsigned integer, 1, 2, 4 or 8 Bytes, 8 Bytes decoded up to INT64_MAX
+        DECIMAL,                        /// float or double
+        STRING,                         /// char array, NULL terminated
+    }TYPE;
+
+    const char* key;                    ///< Attribute/property string, NULL terminated
+    uint16_t    offset;                 ///< Field offset within struct, Bytes
+    uint8_t     size;                   ///< Field size, Bytes
+    uint8_t     type;                   ///< Field type, see \ref TYPE
+}; // struct JSONBindField
+
+
+/**
+ * Bound field type of struct member type.  Integer types by sign, others by specialisation
+ *
+ * \tparam T Member type
+ */
+template<typename T>
+struct JSONBindType {
+    static const uint8_t TYPE = (static_cast<T>(-1) < static_cast<T>(0)) ? JSONBindField::INT : JSONBindField::UINT;
+};
+
+template<>
+struct JSONBindType<bool> {
+    static const uint8_t TYPE = JSONBindField::BOOL;
+};
+
+template<>
+struct JSONBindType<float> {
+    static const uint8_t TYPE = JSONBindField::DECIMAL;
+};
+
+template<>
+struct JSONBindType<double> {
+    static const uint8_t TYPE = JSONBindField::DECIMAL;
+};
+
+template<uint16_t N>
+struct JSONBindType<char[N]> {
+    static const uint8_t TYPE = JSONBindField::STRING;
+};
+
+
+/**
+ * Macro, struct field binding table entry
+ *
+ * \param[in] S Struct type
+ * \param[in] f Field name
+ * \param[in] k Attribute/property string literal
+ */
+#define GJSON_BIND_FIELD(S, f, k)   { k, static_cast<uint16_t>(offsetof(S, f)), static_cast<uint8_t>(sizeof(((S*)0)->f)), \
+                                      gjson::JSONBindType<decltype(((S*)0)->f)>::TYPE }
+
+
+/**
+ * Conversion of JSON values into bound fields, shared by \ref JSONBind and \ref JSONColumns
+ *
+ * \tparam LENGTH Maximum length (including NULL terminator) in characters of a string attribute/property
+ */
+template<uint8_t LENGTH>
+struct JSONBindValue {
+    /**
+     * Store value into struct field
+     *
+     * \param[in] b Binding
+     * \param[out] p Pointer to field
+     * \param[in] v Value string element
+     * \retval true Success
+     * \retval false Value type does not suit field or integer out of field range
+     */
+    static bool Store(const JSONBindField& b, uint8_t* p, const JSONString<LENGTH>* v) {
+        const char* d = v->Data();
+
+        switch(b.type) {
+            case JSONBindField::BOOL :
+                if (!v->IsBoolean()) {
+                    return false;
+                }
+                *reinterpret_cast<bool*>(p) = ('t' == d[0]);
+            break;
+
+            case JSONBindField::INT :
+            case JSONBindField::UINT : {
+                const uint8_t bits = (JSONBindField::UINT == b.type) ? 8 * b.size : 8 * b.size - 1;
+                // 8 Bytes limited to int64_t range of JSONSupport::ToInt
+                const int64_t hi = (bits < 63) ? (static_cast<int64_t>(1) << bits) - 1 : static_cast<int64_t>(static_cast<uint64_t>(-1) >> 1);
+                const int64_t lo = (JSONBindField::UINT == b.type) ? 0 : -hi - 1;
+                int64_t n;
+
+                if (!v->IsValueLiteral() || !v->IsInt() || !JSONSupport::ToInt(d, v->Length(), n) || n < lo || n > hi) {
+                    return false;
+                }
+                if (1 == b.size) {
+                    *p = static_cast<uint8_t>(n);
+                }else if (2 == b.size) {
+                    *reinterpret_cast<uint16_t*>(p) = static_cast<uint16_t>(n);
+                }else if (4 == b.size) {
+                    *reinterpret_cast<uint32_t*>(p) = static_cast<uint32_t>(n);
+                }else {
+                    *reinterpret_cast<uint64_t*>(p) = static_cast<uint64_t>(n);
+                }
+            }
+            break;
+
+            case JSONBindField::DECIMAL :
+                if (!v->IsValueLiteral() || (!v->IsInt() && !v->IsDecimal())) {
+                    return false;
+                }
+                if (sizeof(float) == b.size) {
+                    *reinterpret_cast<float*>(p) = static_cast<float>(atof(d));
+                }else {
+                    *reinterpret_cast<double*>(p) = atof(d);
+                }
+            break;
+
+            case JSONBindField::STRING : {
+                uint16_t l = v->Length();
+
+                if (l >= b.size) {
+                    l = b.size - 1;
+                }
+                strncpy(reinterpret_cast<char*>(p), d, l);
+                reinterpret_cast<char*>(p)[l] = '\0';
+            }
+            break;
+        }
+
+        return true;
+    } // Store(...)
+}; // struct JSONBindValue
+
+
+/**
+ * JSON non-recursive string parser by subclass binding attributes/properties of a fixed shape JSON map directly to
+ * the fields of a struct, with a matching encoder.  Neither allocate; decode runs on the \ref JSONParse::FromString
+ * tokeniser without object chain and attribute/properties are looked up by a perfect hash made once at construction.
+ *
+ * Only attributes/properties of the outer map are bound, others (and nested arrays or maps) are ignored.
+ *
+ * \tparam LENGTH Maximum length (including NULL terminator) in characters of a string attribute/property
+ * \tparam S Struct type
+ * \tparam SLOTS Hash table slots, power of 2 and not less than number of bound fields.  Default 16
+ */
+template<uint8_t LENGTH, typename S, uint8_t SLOTS=16>
+class JSONBind : protected JSONParse<LENGTH, JSONBind<LENGTH, S, SLOTS> > {
+    typedef JSONParse<LENGTH, JSONBind<LENGTH, S, SLOTS> > Parse;    ///< Base parser, callbacks bound at compile time
+    friend class JSONParse<LENGTH, JSONBind<LENGTH, S, SLOTS> >;
+
+public:
+    /**
+     * \copydoc JSONParse::ERR
+     */
+    using Parse::ERR;
+
+
+    /**
+     * \copydoc JSONParse::GetLastError
+     */
+    using Parse::GetLastError;
+
+
+    /**
+     * \copydoc JSONParse::Length
+     */
+    using Parse::Length;
+
+
+    /**
+     * \copydoc JSONParse::Get
+     */
+    using Parse::Get;
+
+
+    /**
+     * Constructor, make stable instance with given I/O instance and binding table
+     *
+     * \tparam N Number of bound fields
+     * \param[in,out] io Pointer to I/O instance, source of JSON string for decode and destination for encode
+     * \param[in] fields Binding table, see \ref GJSON_BIND_FIELD.  Referenced not copied
+     * \param[in] places Encoded decimal places, trailing zeros removed.  Default 6
+     */
+    template<uint8_t N>
+    JSONBind(IO* io, const JSONBindField (&fields)[N], const uint8_t places=6) : Parse(io, 0U), fields_(fields), n_(N), \
+                                places_(places), seed_(0), hashed_(false), field_(NONE), out_(NULL), decoded_(0) {
+        Parse::Callbacks(true);
+        MakeHash();
+    }
+
+
+    /**
+     * Decode JSON string of I/O into struct.  Fields without attribute/property in JSON string are
+     * left unchanged, see \ref GetDecoded
+     *
+     * \attention Caller should check \ref GetLastError upon completion for any error
+     * condition that may have risen during parse.  ERR_BAD_VALUE when a value type does not suit
+     * its field or an integer is out of its field range
+     *
+     * \param[out] out Pointer to struct
+     * \param[in] psi Parse start character >=0 index < \ref Length, default 0
+     * \return Last character index parsed
+     */
+    uint16_t Decode(S* out, const uint16_t psi=0) {
+        out_ = reinterpret_cast<uint8_t*>(out);
+        field_ = NONE;
+        decoded_ = 0;
+
+        return Parse::FromString(psi);
+    } // Decode(...)
+
+
+    /**
+     * Get fields decoded by last \ref Decode
+     *
+     * \return Bit set, bit n for binding table entry n.  First 32 entries only
+     */
+    uint32_t GetDecoded() const {
+        return decoded_;
+    }
+
+
+    /**
+     * Encode struct into I/O as JSON map, all bound fields in binding table order
+     *
+     * \param[in] in Pointer to struct
+     * \retval true Success
+     * \retval false Failure, check \ref GetLastError
+     */
+    bool Encode(const S* in) {
+        const uint8_t* p = reinterpret_cast<const uint8_t*>(in);
+        JSONWriter w(Parse::io_, places_);
+        uint8_t f;
+
+        w.BeginMap();
+        for(f=0; f<n_; f++) {
+            const JSONBindField& b = fields_[f];
+            const uint8_t* v = p + b.offset;
+
+            w.Key(b.key);
+            switch(b.type) {
+                case JSONBindField::BOOL :
+                    w.Value(*reinterpret_cast<const bool*>(v));
+                break;
+
+                case JSONBindField::INT :
+                    w.Value(static_cast<long long>(LoadInt(v, b.size)));
+                break;
+
+                case JSONBindField::UINT :
+                    w.Value(static_cast<unsigned long long>(LoadUInt(v, b.size)));
+                break;
+
+                case JSONBindField::DECIMAL :
+                    w.Value((sizeof(float) == b.size) ? *reinterpret_cast<const float*>(v) : *reinterpret_cast<const double*>(v));
+                break;
+
+                case JSONBindField::STRING :
+                    w.Value(reinterpret_cast<const char*>(v));
+                break;
+            }
+        }
+        w.EndMap();
+        Parse::Error(w.GetLastError());
+
+        return (Parse::ERR_NONE == w.GetLastError());
+    } // Encode(...)
+
+
+    bool TokenArray(const JSONArray<LENGTH>* e, char *s=NULL, uint16_t i=0) {
+        return TokenContainer(e);
+    } // TokenArray(...)
+
+
+    bool TokenMap(const JSONArray<LENGTH>* e, char *s=NULL, uint16_t i=0) {
+        return TokenContainer(e);
+    } // TokenMap(...)
+
+
+    bool TokenString(const JSONString<LENGTH>* e, char *s=NULL, int16_t si=0, int16_t ei=0) {
+        if (Parse::OP_FROM_STRING == Parse::GetLastOperation() && 1 == Parse::Depth()) {
+            if (!e->IsValue()) {
+                field_ = Lookup(e->Data(), e->Length());
+            }else if (NONE != field_) {
+                if (!JSONBindValue<LENGTH>::Store(fields_[field_], out_ + fields_[field_].offset, e)) {
+                    Parse::Error(Parse::ERR_BAD_VALUE);
+                }else if (field_ < 32) {
+                    decoded_ |= (1UL << field_);
+                }
+                field_ = NONE;
+            }
+        }
+
+        return false;
+    } // TokenString(...)
+
+protected:
+    static const uint8_t NONE = 0xff;       ///< No field index
+
+
+    /**
+     * Hash attribute/property string
+     *
+     * \param[in] k String, not necessarily terminated
+     * \param[in] l String length, characters
+     * \param[in] seed Hash seed
+     * \return Slot index
+     */
+    static uint8_t Hash(const char* k, const uint16_t l, const uint8_t seed) {
+        uint8_t h = seed;
+        uint16_t i;
+
+        for(i=0; i<l; i++) {
+            h = static_cast<uint8_t>((h * 31) ^ k[i]);
+        }
+
+        return h & (SLOTS - 1);
+    } // Hash(...)
+
+
+    /**
+     * Find hash seed placing every bound field in its own slot.  Falls back to search of binding
+     * table when no seed found
+     */
+    void MakeHash() {
+        uint16_t seed;
+        uint8_t f;
+
+        hashed_ = false;
+        if (n_ > SLOTS) {
+            return;
+        }
+        for(seed=0; seed<256; seed++) {
+            for(f=0; f<SLOTS; f++) {
+                slot_[f] = NONE;
+            }
+            for(f=0; f<n_; f++) {
+                uint8_t h = Hash(fields_[f].key, strlen(fields_[f].key), static_cast<uint8_t>(seed));
+
+                if (NONE != slot_[h]) {
+                    break;    // Collision
+                }
+                slot_[h] = f;
+            }
+            if (f == n_) {
+                seed_ = static_cast<uint8_t>(seed);
+                hashed_ = true;
+                return;
+            }
+        }
+        hashed_ = false;    // No perfect hash, too many fields for slots
+    } // MakeHash(...)
+
+
+    /**
+     * Look up bound field by attribute/property
+     *
+     * \param[in] k Attribute/property string, NULL terminated
+     * \param[in] l String length, characters
+     * \return Binding table index or NONE
+     */
+    uint8_t Lookup(const char* k, const uint16_t l) const {
+        uint8_t f;
+
+        if (hashed_) {
+            f = slot_[Hash(k, l, seed_)];
+            if (NONE != f && !GJSON_REPLACE_STRNCMP(k, fields_[f].key, strlen(fields_[f].key))) {
+                return f;
+            }
+            return NONE;
+        }
+        for(f=0; f<n_; f++) {
+            if (!GJSON_REPLACE_STRNCMP(k, fields_[f].key, strlen(fields_[f].key))) {
+                return f;
+            }
+        }
+
+        return NONE;
+    } // Lookup(...)
+
+
+    /**
+     * Handle array or map element for both \ref TokenArray and \ref TokenMap.  Bound fields
+     * cannot take array or map values
+     *
+     * \param[in] e Array or map element pointer
+     * \return false, continue parsing
+     */
+    bool TokenContainer(const JSONArray<LENGTH>* e) {
+        if (Parse::OP_FROM_STRING == Parse::GetLastOperation()) {
+            if (NONE != field_ && e->IsOpen() && 1 == Parse::Depth()) {
+                Parse::Error(Parse::ERR_BAD_VALUE);
+            }
+        }
+
+        return false;
+    } // TokenContainer(...)
+
+
+    /**
+     * Load signed integer field
+     *
+     * \param[in] p Pointer to field
+     * \param[in] size Field size, Bytes
+     * \return Value
+     */
+    static int64_t LoadInt(const uint8_t* p, const uint8_t size) {
+        if (1 == size) {
+            return *reinterpret_cast<const int8_t*>(p);
+        }else if (2 == size) {
+            return *reinterpret_cast<const int16_t*>(p);
+        }else if (4 == size) {
+            return *reinterpret_cast<const int32_t*>(p);
+        }
+
+        return *reinterpret_cast<const int64_t*>(p);
+    } // LoadInt(...)
+
+
+    /**
+     * Load unsigned integer field
+     *
+     * \param[in] p Pointer to field
+     * \param[in] size Field size, Bytes
+     * \return Value
+     */
+    static uint64_t LoadUInt(const uint8_t* p, const uint8_t size) {
+        if (1 == size) {
+            return *p;
+        }else if (2 == size) {
+            return *reinterpret_cast<const uint16_t*>(p);
+        }else if (4 == size) {
+            return *reinterpret_cast<const uint32_t*>(p);
+        }
+
+        return *reinterpret_cast<const uint64_t*>(p);
+    } // LoadUInt(...)
+
+
+    const JSONBindField* fields_;           ///< Binding table pointer
+    uint8_t     n_;                         ///< Binding table entries
+    uint8_t     places_;                    ///< Encoded decimal places
+    uint8_t     seed_;                      ///< Perfect hash seed
+    bool        hashed_;                    ///< Perfect hash made flag
+    uint8_t     slot_[SLOTS];               ///< Binding table index of each hash slot or NONE
+    uint8_t     field_;                     ///< Binding table index of pending attribute/property or NONE
+    uint8_t*    out_;                       ///< Decode struct pointer
+    uint32_t    decoded_;                   ///< Decoded fields bit set
+}; // class JSONBind
+
+}; // namespace gjson
+
+#endif // GJSON_BIND_H
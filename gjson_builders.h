@@ -104,6 +104,35 @@ protected:
     JSONString<LENGTH>            p_;       ///< Attribute/property item
 }; // class JSONMapTupleArray
 
+
+/**
+ * A builder, helper class representing a JSON tuple (Map) between a string property/attribute and raw JSON text, e.g. an 
+ * envelope around a forwarded payload.  Parser will not use this type of element in-memory.
+ *
+ * This class inherits from JSON raw for the property value and contains another string for the property/attribute name.  It was important to keep this layout as
+ * \ref JSONElement::Next() isn't virtual.
+ *
+ * \tparam LENGTH Maximum length (including NULL terminator) in characters of a string attribute/property
+ */
+template<uint8_t LENGTH>
+class JSONMapTupleRaw : public JSONRaw<LENGTH> {
+public:
+    /**
+     * Constructor, make stable instance.  Specify a tuple with name, JSON text and optional parent element
+     *
+     * \param[in] p Pointer attribute/property NULL terminated string
+     * \param[in] s Pointer to JSON text, need not be NULL terminated
+     * \param[in] l Text length, characters
+     * \param[in] e Pointer, parent element or NULL (no parent yet)
+     */
+    JSONMapTupleRaw(const char* p, const char* s, const uint16_t l, JSONElement<LENGTH>* e=NULL) : JSONRaw<LENGTH>(s, l), p_(JSONString<LENGTH>(p, e, false)) {        // p String : v Raw
+        p_.Next(this);
+    }
+
+protected:
+    JSONString<LENGTH>            p_;       ///< Attribute/property item
+}; // class JSONMapTupleRaw
+
 }; // namespace gjson
 
 #endif // GJSON_BUILDERS_H
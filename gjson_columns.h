@@ -0,0 +1,274 @@
+/**
+ * \file
+ * Embedded JSON builder and parser - Columnar extraction
+ * PROJECT: GJSON library
+ * TARGET SYSTEM: Arduino, STM32, Atmel AT91SAM, portable
+ */
+
+#ifndef GJSON_COLUMNS_H
+#define GJSON_COLUMNS_H
+
+namespace gjson {
+
+/**
+ * Column of an array of records, taking one attribute/property of each record into a typed array.  Declare a
+ * table of these using \ref GJSON_COLUMN, e.g.
+ *
+ * int32_t ts[64];
+ * float value[64];
+ *
+ * gjson::JSONColumn columns[] = {
+ *     GJSON_COLUMN(ts, "ts"),
+ *     GJSON_COLUMN(value, "value"),
+ * };
+ */
+struct JSONColumn {
+    const char* key;                    ///< Attribute/property string, NULL terminated
+    void*       data;                   ///< Column array
+    uint16_t    rows;                   ///< Column array items
+    uint8_t     size;                   ///< Item size, Bytes
+    uint8_t     type;                   ///< Item type, see \ref JSONBindField::TYPE
+}; // struct JSONColumn
+
+
+/**
+ * Bound field type of column array item type, declaration only for use by \ref GJSON_COLUMN
+ *
+ * \tparam T Item type
+ * \tparam N Items
+ */
+template<typename T, size_t N>
+JSONBindType<T> JSONColumnType(T (&a)[N]);
+
+
+/**
+ * Macro, column table entry
+ *
+ * \param[in] a Column array
+ * \param[in] k Attribute/property string literal
+ */
+#define GJSON_COLUMN(a, k)          { k, a, static_cast<uint16_t>(sizeof(a) / sizeof(a[0])), static_cast<uint8_t>(sizeof(a[0])), \
+                                      decltype(gjson::JSONColumnType(a))::TYPE }
+
+
+/**
+ * JSON non-recursive string parser by subclass extracting attribute/properties of an array of records (maps)
+ * straight into column arrays, struct of arrays.  Runs on the \ref JSONParse::FromString tokeniser without
+ * object chain so nothing is allocated; row n of every column is from record n.
+ *
+ * Records are the maps of the array parsing starts at, attribute/properties of records not in the column table
+ * and nested arrays or maps are ignored.  A record without an attribute/property leaves its column item zero
+ * (empty string).  To extract an array within a larger JSON string give its start as parse start index,
+ * \ref JSONPointer finds it.
+ *
+ * When column arrays fill before the records end extraction stops, see \ref Extract, process the rows then
+ * extract again to continue.
+ *
+ * \tparam LENGTH Maximum length (including NULL terminator) in characters of a string attribute/property
+ */
+template<uint8_t LENGTH>
+class JSONColumns : protected JSONParse<LENGTH, JSONColumns<LENGTH> > {
+    typedef JSONParse<LENGTH, JSONColumns<LENGTH> > Parse;    ///< Base parser, callbacks bound at compile time
+    friend class JSONParse<LENGTH, JSONColumns<LENGTH> >;
+
+public:
+    /**
+     * \copydoc JSONParse::ERR
+     */
+    using Parse::ERR;
+
+
+    /**
+     * \copydoc JSONParse::GetLastError
+     */
+    using Parse::GetLastError;
+
+
+    /**
+     * \copydoc JSONParse::Length
+     */
+    using Parse::Length;
+
+
+    /**
+     * Constructor, make stable instance with given I/O instance and column table
+     *
+     * \tparam N Number of columns, 32 or less
+     * \param[in,out] io Pointer to I/O instance, source of JSON string
+     * \param[in] columns Column table, see \ref GJSON_COLUMN.  Referenced not copied
+     */
+    template<uint8_t N>
+    JSONColumns(IO* io, const JSONColumn (&columns)[N]) : Parse(io, 0U), columns_(columns), n_(N), column_(NONE), rows_(0), \
+                                max_(0xffff), filled_(0) {
+        static_assert(N <= 32, "JSONColumns filled bit set holds 32 columns");
+        uint8_t c;
+
+        for(c=0; c<n_; c++) {
+            if (columns_[c].rows < max_) {
+                max_ = columns_[c].rows;
+            }
+        }
+        Parse::Callbacks(true);
+    }
+
+
+    /**
+     * Extract records of JSON string of I/O into column arrays, from row 0
+     *
+     * \attention Caller should check \ref GetLastError upon completion for any error condition that may have risen
+     * during parse.  ERR_BAD_VALUE when a value type does not suit its column or an integer is out of its range.  ERR_CALLBACK_STOP when
+     * column arrays filled before the records end, invoke again to continue with the next record (start index ignored)
+     *
+     * \param[in] psi Parse start character >=0 index < \ref Length of records array, default 0
+     * \return Rows extracted
+     */
+    uint16_t Extract(const uint16_t psi=0) {
+        rows_ = 0;
+        filled_ = 0;
+        column_ = NONE;
+        if (Length() && psi < Length()) {
+            Parse::FromString(const_cast<char*>(Parse::io_->Get()), NULL, psi, &ps_);
+        }
+
+        return rows_;
+    } // Extract(...)
+
+
+    /**
+     * Query whether records remain after extraction stopped on full column arrays
+     *
+     * \retval true Further records, \ref Extract to continue
+     * \retval false Extraction complete
+     */
+    bool IsMore() const {
+        return ps_.IsActive();
+    }
+
+
+    /**
+     * Abandon stopped extraction, next \ref Extract starts afresh
+     */
+    void Reset() {
+        ps_.Reset();
+    }
+
+
+    /**
+     * Get rows extracted by last \ref Extract
+     *
+     * \return Rows
+     */
+    uint16_t GetRows() const {
+        return rows_;
+    }
+
+
+    bool TokenArray(const JSONArray<LENGTH>* e, char *s=NULL, uint16_t i=0) {
+        return TokenContainer(e, false);
+    } // TokenArray(...)
+
+
+    bool TokenMap(const JSONArray<LENGTH>* e, char *s=NULL, uint16_t i=0) {
+        return TokenContainer(e, true);
+    } // TokenMap(...)
+
+
+    bool TokenString(const JSONString<LENGTH>* e, char *s=NULL, int16_t si=0, int16_t ei=0) {
+        if (2 == Parse::Depth()) {
+            if (!e->IsValue()) {
+                column_ = Lookup(e->Data(), e->Length());
+            }else if (NONE != column_) {
+                const JSONColumn& c = columns_[column_];
+                const JSONBindField b = { c.key, 0, c.size, c.type };
+
+                if (!JSONBindValue<LENGTH>::Store(b, Item(column_), e)) {
+                    Parse::Error(Parse::ERR_BAD_VALUE);
+                }
+                filled_ |= (1UL << column_);
+                column_ = NONE;
+            }
+        }
+
+        return false;
+    } // TokenString(...)
+
+protected:
+    static const uint8_t NONE = 0xff;       ///< No column index
+
+
+    /**
+     * Get item of current row
+     *
+     * \param[in] c Column index
+     * \return Item pointer
+     */
+    uint8_t* Item(const uint8_t c) const {
+        return static_cast<uint8_t*>(columns_[c].data) + static_cast<uint32_t>(rows_) * columns_[c].size;
+    }
+
+
+    /**
+     * Look up column by attribute/property
+     *
+     * \param[in] k Attribute/property string, NULL terminated
+     * \param[in] l String length, characters
+     * \return Column table index or NONE
+     */
+    uint8_t Lookup(const char* k, const uint16_t l) const {
+        uint8_t c;
+
+        for(c=0; c<n_; c++) {
+            if (k[0] == columns_[c].key[0] && !GJSON_REPLACE_STRNCMP(k, columns_[c].key, l + 1)) {
+                return c;
+            }
+        }
+
+        return NONE;
+    } // Lookup(...)
+
+
+    /**
+     * Handle array or map element for both \ref TokenArray and \ref TokenMap.  Record maps open and complete
+     * rows, columns cannot take array or map values
+     *
+     * \param[in] e Array or map element pointer
+     * \param[in] is_map Element is map flag
+     * \retval true Stop parsing, column arrays full
+     * \retval false Continue parsing
+     */
+    bool TokenContainer(const JSONArray<LENGTH>* e, const bool is_map) {
+        int16_t d = Parse::Depth();
+
+        if (NONE != column_ && e->IsOpen() && 2 == d) {
+            Parse::Error(Parse::ERR_BAD_VALUE);
+        }else if (is_map && e->IsOpen() && 1 == d) {
+            filled_ = 0;    // Record begins
+            column_ = NONE;
+        }else if (is_map && !e->IsOpen() && 2 == d) {
+            // Record ends, zero what it didn't have
+            for(uint8_t c=0; c<n_; c++) {
+                if (!(filled_ & (1UL << c))) {
+                    memset(Item(c), 0, columns_[c].size);
+                }
+            }
+            rows_++;
+
+            return (rows_ >= max_);
+        }
+
+        return false;
+    } // TokenContainer(...)
+
+
+    const JSONColumn* columns_;             ///< Column table pointer
+    uint8_t     n_;                         ///< Column table entries
+    uint8_t     column_;                    ///< Column table index of pending attribute/property or NONE
+    uint16_t    rows_;                      ///< Rows extracted
+    uint16_t    max_;                       ///< Rows of smallest column array
+    uint32_t    filled_;                    ///< Columns of current row filled bit set
+    JSONParseState ps_;                     ///< Parse state, active when extraction stopped on full columns
+}; // class JSONColumns
+
+}; // namespace gjson
+
+#endif // GJSON_COLUMNS_H
@@ -0,0 +1,488 @@
+/**
+ * \file
+ * Embedded JSON builder and parser - Object chain editing
+ * PROJECT: GJSON library
+ * TARGET SYSTEM: Arduino, STM32, Atmel AT91SAM, portable
+ */
+
+#ifndef GJSON_EDIT_H
+#define GJSON_EDIT_H
+
+namespace gjson {
+
+/**
+ * Cursor over an object chain for structural edits; insert, remove and move (cut then insert) map members and array
+ * elements.  Cursor keeps the element before its current one so an edit relinks two elements without scanning the
+ * chain for a predecessor, and updates head of chain when its first element changes.
+ *
+ * An item is a value with its attribute/property when a map member; a string, packed numbers, raw text or an
+ * array or map from open to close.  Editing works on whole items so object chain stays balanced.
+ *
+ *   JSONCursor<12> c(&h, &pool);    // At root map open
+ *   c.Member("list");               // Attribute/property of member
+ *   c.Remove();                     // Member gone, elements to pool
+ *
+ * \attention Keep object chain unchanged other than by this cursor while cursor is in use, or \ref Reset
+ *
+ * \tparam LENGTH Maximum length (including NULL terminator) in characters of a string attribute/property
+ */
+template<uint8_t LENGTH>
+class JSONCursor : public JSONConstant {
+public:
+    /**
+     * Constructor, make stable instance at start of object chain
+     *
+     * \param[in,out] h Pointer to pointer of first JSON element in object chain, updated by edits of first element
+     * \param[in] pool Pointer to element pool taking removed and giving inserted elements or NULL, heap
+     */
+    JSONCursor(JSONElement<LENGTH>** h, JSONNodePool<LENGTH>* pool=NULL) : h_(h), pool_(pool), intern_(NULL), ks_(false) {
+        Reset();
+    }
+
+
+    /**
+     * Set intern table of object chain parsed with one, see \ref JSONParse::Intern.  Needed by \ref Member to
+     * compare interned attribute/properties
+     *
+     * \param[in] intern Pointer to intern table or NULL
+     */
+    void Intern(const JSONIntern<LENGTH>* intern) {
+        intern_ = intern;
+    }
+
+
+    /**
+     * Move cursor to start of object chain
+     */
+    void Reset() {
+        c_ = *h_;
+        p_ = NULL;
+        last_error_ = ERR_NONE;
+    }
+
+
+    /**
+     * Get current element
+     *
+     * \return Element pointer or NULL, end of object chain
+     */
+    JSONElement<LENGTH>* Get() const {
+        return c_;
+    }
+
+
+    /**
+     * Get element before current
+     *
+     * \return Element pointer or NULL, current is first
+     */
+    JSONElement<LENGTH>* Previous() const {
+        return p_;
+    }
+
+
+    /**
+     * Move cursor to next element, into an array or map when at its open
+     *
+     * \retval true Success
+     * \retval false Failure, end of object chain
+     */
+    bool Next() {
+        if (!c_) {
+            last_error_ = ERR_NOT_FOUND;
+            return false;
+        }
+        p_ = c_;
+        c_ = c_->Next();
+
+        return true;
+    } // Next(...)
+
+
+    /**
+     * Move cursor past current item to the item after, over any array or map it holds
+     *
+     * \retval true Success
+     * \retval false Failure, at array or map close or end of object chain
+     */
+    bool NextItem() {
+        JSONElement<LENGTH>* l = ItemEnd(c_);
+
+        if (!l) {
+            last_error_ = ERR_NOT_FOUND;
+            return false;
+        }
+        p_ = l;
+        c_ = l->Next();
+
+        return true;
+    } // NextItem(...)
+
+
+    /**
+     * Move cursor from map open to attribute/property of member
+     *
+     * \param[in] key Attribute/property, NULL terminated
+     * \retval true Success
+     * \retval false Failure, not at map open or not found.  Cursor unchanged
+     */
+    bool Member(const char* key) {
+        JSONElement<LENGTH>* c = c_;
+        JSONElement<LENGTH>* p = p_;
+        uint16_t kl = strlen(key);
+
+        if (!IsOpen(c_, JSONElement<LENGTH>::MAP)) {
+            last_error_ = ERR_BAD_VALUE;
+            return false;
+        }
+        Next();
+        while(c_ && ItemEnd(c_)) {
+            const JSONString<LENGTH>* k = Key(c_);
+
+            if (k && k->Length() == kl && GJSON_REPLACE_STRNCMP(k->Data(), key, kl) >= 0) {
+                return true;
+            }
+            NextItem();
+        }
+        c_ = c;
+        p_ = p;
+        last_error_ = ERR_NOT_FOUND;
+
+        return false;
+    } // Member(...)
+
+
+    /**
+     * Move cursor from array open to element
+     *
+     * \param[in] index Element index, number of elements moves to array close so \ref Insert appends
+     * \retval true Success
+     * \retval false Failure, not at array open or index beyond end.  Cursor unchanged
+     */
+    bool Element(const uint16_t index) {
+        JSONElement<LENGTH>* c = c_;
+        JSONElement<LENGTH>* p = p_;
+        uint16_t i;
+
+        if (!IsOpen(c_, JSONElement<LENGTH>::ARRAY)) {
+            last_error_ = ERR_BAD_VALUE;
+            return false;
+        }
+        Next();
+        for(i=0; i<index && NextItem(); i++);
+        if (i == index && c_) {
+            return true;
+        }
+        c_ = c;
+        p_ = p;
+        last_error_ = ERR_NOT_FOUND;
+
+        return false;
+    } // Element(...)
+
+
+    /**
+     * Move cursor from array or map open to its close, so \ref Insert appends
+     *
+     * \retval true Success
+     * \retval false Failure, not at array or map open or unbalanced
+     */
+    bool End() {
+        JSONElement<LENGTH>* l = ItemEnd(c_);
+
+        if (!l || (!IsOpen(c_, JSONElement<LENGTH>::ARRAY) && !IsOpen(c_, JSONElement<LENGTH>::MAP))) {
+            last_error_ = ERR_BAD_VALUE;
+            return false;
+        }
+        while(c_->Next() != l) {
+            Next();
+        }
+        Next();
+
+        return true;
+    } // End(...)
+
+
+    /**
+     * Insert elements before current, cursor moves to first inserted.  Elements should be whole items, with
+     * attribute/property when inserted in a map
+     *
+     * \param[in] first Pointer to first element to insert
+     * \param[in] last Pointer to last element to insert or NULL, end of chain from first
+     * \retval true Success
+     * \retval false Failure, nothing to insert or link out of range (see \ref JSONElement::Next)
+     */
+    bool Insert(JSONElement<LENGTH>* first, JSONElement<LENGTH>* last=NULL) {
+        if (!first) {
+            last_error_ = ERR_BAD_VALUE;
+            return false;
+        }
+        if (!last) {
+            for(last=first; last->Next(); last=last->Next());
+        }
+        if (!Link(last, c_)) {
+            last_error_ = ERR_OBJECT_MEMORY_LIMIT;
+            return false;
+        }
+        if (!Link(p_, first)) {
+            Link(p_, c_);    // Restore
+            last_error_ = ERR_OBJECT_MEMORY_LIMIT;
+            return false;
+        }
+        c_ = first;
+
+        return true;
+    } // Insert(...)
+
+
+    /**
+     * Insert string value before current, from pool or heap
+     *
+     * \param[in] value Value string, NULL terminated
+     * \param[in] is_literal IsLiteral boolean, when true indicates string value is literal, default false
+     * \retval true Success
+     * \retval false Failure, out of memory or link out of range
+     */
+    bool InsertValue(const char* value, const bool is_literal=false) {
+        JSONString<LENGTH>* v = NewString(true);
+
+        if (!v) {
+            return false;
+        }
+        v->Data(value, is_literal);
+        if (!Insert(v, v)) {
+            Release(v);
+            return false;
+        }
+
+        return true;
+    } // InsertValue(...)
+
+
+    /**
+     * Insert map member of string value before current, from pool or heap
+     *
+     * \param[in] key Attribute/property string, NULL terminated
+     * \param[in] value Value string, NULL terminated
+     * \param[in] is_literal IsLiteral boolean, when true indicates string value is literal, default false
+     * \retval true Success
+     * \retval false Failure, out of memory or link out of range
+     */
+    bool InsertMember(const char* key, const char* value, const bool is_literal=false) {
+        JSONString<LENGTH>* k = NewString(false);
+        JSONString<LENGTH>* v = k ? NewString(true) : NULL;
+
+        if (!v) {
+            if (k) {
+                Release(k);
+            }
+            return false;
+        }
+        k->Data(key);
+        v->Data(value, is_literal);
+        if (!k->Next(v) || !Insert(k, v)) {
+            Release(k);
+            Release(v);
+            last_error_ = ERR_OBJECT_MEMORY_LIMIT;
+            return false;
+        }
+
+        return true;
+    } // InsertMember(...)
+
+
+    /**
+     * Detach current item from object chain, cursor moves to element after it
+     *
+     * \return Pointer to first element of detached item, ending object chain of its own, or NULL (at array or map 
+     * close, end of object chain or link out of range).  Caller owns it, see \ref Insert to place elsewhere
+     */
+    JSONElement<LENGTH>* Cut() {
+        JSONElement<LENGTH>* l = ItemEnd(c_);
+        JSONElement<LENGTH>* f = c_;
+
+        if (!l) {
+            last_error_ = ERR_NOT_FOUND;
+            return NULL;
+        }
+        if (!Link(p_, l->Next())) {
+            Link(p_, f);    // Restore
+            last_error_ = ERR_OBJECT_MEMORY_LIMIT;
+            return NULL;
+        }
+        c_ = l->Next();
+        l->Unlink();
+
+        return f;
+    } // Cut(...)
+
+
+    /**
+     * Remove current item from object chain, its elements to pool or heap.  Cursor moves to element after it
+     *
+     * \retval true Success
+     * \retval false Failure, at array or map close or end of object chain
+     */
+    bool Remove() {
+        JSONElement<LENGTH>* f = Cut();
+        bool r = (NULL != f);
+
+        while(f) {
+            JSONElement<LENGTH>* n = f->Next();
+
+            Release(f);
+            f = n;
+        }
+
+        return r;
+    } // Remove(...)
+
+
+    /**
+     * Get last error condition (if any).  For list see enum \ref ERR
+     *
+     * \return ERR numeric
+     */
+    ERR GetLastError() const {
+        return last_error_;
+    }
+
+
+    /**
+     * Get last element of item
+     *
+     * \param[in] e Pointer to first element of item or NULL
+     * \return Element pointer or NULL, e is array or map close, unbalanced or NULL
+     */
+    static JSONElement<LENGTH>* ItemEnd(JSONElement<LENGTH>* e) {
+        int16_t d = 0;
+
+        if (e && (JSONElement<LENGTH>::KEY == e->Type() || (JSONElement<LENGTH>::STRING == e->Type() &&
+                                !reinterpret_cast<JSONString<LENGTH>*>(e)->IsValue()))) {
+            e = e->Next();    // Attribute/property, item is its value
+        }
+        for(; e; e=e->Next()) {
+            switch(e->Type()) {
+                case JSONElement<LENGTH>::ARRAY :
+                case JSONElement<LENGTH>::MAP :
+                    d += reinterpret_cast<JSONArray<LENGTH>*>(e)->IsOpen() ? 1 : -1;
+                break;
+
+                case JSONElement<LENGTH>::RAW :
+                    d += reinterpret_cast<JSONRaw<LENGTH>*>(e)->Arrays() + reinterpret_cast<JSONRaw<LENGTH>*>(e)->Maps();
+                break;
+
+                default :
+                break;
+            }
+            if (d <= 0) {
+                return d ? NULL : e;
+            }
+        }
+
+        return NULL;
+    } // ItemEnd(...)
+
+protected:
+    /**
+     * Query element is array or map open
+     *
+     * \param[in] e Pointer to element or NULL
+     * \param[in] type ARRAY or MAP
+     * \return Boolean
+     */
+    static bool IsOpen(JSONElement<LENGTH>* e, const typename JSONElement<LENGTH>::TYPE type) {
+        return (e && type == e->Type() && reinterpret_cast<JSONArray<LENGTH>*>(e)->IsOpen());
+    }
+
+
+    /**
+     * Get attribute/property string of element
+     *
+     * \param[in] e Pointer to element
+     * \return String pointer or NULL, not attribute/property
+     */
+    const JSONString<LENGTH>* Key(JSONElement<LENGTH>* e) {
+        if (JSONElement<LENGTH>::STRING == e->Type()) {
+            auto s = reinterpret_cast<JSONString<LENGTH>*>(e);
+
+            return s->IsValue() ? NULL : s;
+        }
+        if (JSONElement<LENGTH>::KEY == e->Type() && intern_ && intern_->Key(reinterpret_cast<JSONKey<LENGTH>*>(e)->Id(), &ks_)) {
+            return &ks_;
+        }
+
+        return NULL;
+    } // Key(...)
+
+
+    /**
+     * Link element to next, p NULL making next head of object chain and next NULL ending chain at p
+     *
+     * \param[in] p Pointer to element or NULL
+     * \param[in] n Pointer to next element or NULL
+     * \retval true Success
+     * \retval false Failure, link out of range (see \ref JSONElement::Next)
+     */
+    bool Link(JSONElement<LENGTH>* p, JSONElement<LENGTH>* n) {
+        if (!p) {
+            *h_ = n;
+        }else if (n) {
+            return (NULL != p->Next(n));
+        }else {
+            p->Unlink();
+        }
+
+        return true;
+    }
+
+
+    /**
+     * Get string element, from pool or heap
+     *
+     * \param[in] is_value IsValue boolean
+     * \return Element pointer or NULL, out of memory (last error ERR_OBJECT_MEMORY_LIMIT)
+     */
+    JSONString<LENGTH>* NewString(const bool is_value) {
+        JSONString<LENGTH>* s;
+
+        if (pool_) {
+            s = pool_->String(is_value);
+        }else {
+            s = GJSON_NEW_OBJECT( JSONString<LENGTH>(is_value), JSONString<LENGTH> );
+        }
+
+        if (!s) {
+            last_error_ = ERR_OBJECT_MEMORY_LIMIT;
+        }
+
+        return s;
+    }
+
+
+    /**
+     * Release element, to pool or heap
+     *
+     * \param[in] e Pointer to element, next link is not followed
+     */
+    void Release(JSONElement<LENGTH>* e) {
+        if (pool_) {
+            pool_->Release(e);
+        }else {
+            JSONNodePool<LENGTH>::Free(e);
+        }
+    }
+
+
+    JSONElement<LENGTH>** h_;               ///< Head of object chain
+    JSONElement<LENGTH>* c_;                ///< Current element
+    JSONElement<LENGTH>* p_;                ///< Element before current or NULL
+    JSONNodePool<LENGTH>* pool_;            ///< Element pool or NULL
+    const JSONIntern<LENGTH>* intern_;      ///< Intern table of object chain or NULL
+    JSONString<LENGTH> ks_;                 ///< Interned attribute/property copy
+    ERR         last_error_;                ///< Last error
+}; // class JSONCursor
+
+}; // namespace gjson
+
+#endif // GJSON_EDIT_H
@@ -14,6 +14,9 @@ namespace gjson {
  * A class representing a basic JSON in-memory element.  This is a parent class to all possible JSON element types and
  * JSON strings ultimately get parsed into objects based off this class
  *
+ * \note With build macro \ref GJSON_COMPACT_ELEMENTS type and flags of all element types are packed into a header 
+ * byte and next element is held as offset relative to this element
+ *
  * \tparam LENGTH Maximum length (including NULL terminator) in characters of a string attribute/property
  */
 template<uint8_t LENGTH>
@@ -27,6 +30,9 @@ public:
         ARRAY,
         MAP,
         STRING,
+        KEY,                            ///< Interned attribute/property, see \ref JSONKey
+        NUMBERS,                        ///< Packed array of numbers, see \ref JSONNumbers
+        RAW,                            ///< Pre-serialized JSON text, see \ref JSONRaw
     }TYPE;
 
 
@@ -37,12 +43,45 @@ public:
      *
      * \param[in] e Pointer, parent element or NULL (no parent yet)
      */
+#if GJSON_COMPACT_ELEMENTS
+    JSONElement(JSONElement* e=NULL) : e_(0), flags_(0) { // parent pointer
+#else
     JSONElement(JSONElement* e=NULL) : e_(NULL) { // parent pointer
+#endif // GJSON_COMPACT_ELEMENTS
+        Source(0, 0);
         if (e) {
             e->Next(this);
         }
     }
 
+#if GJSON_COMPACT_ELEMENTS
+
+    /**
+     * Copy constructor, relative next element link is rebased to this element
+     *
+     * \param[in] o Element to copy
+     */
+    JSONElement(const JSONElement& o) : e_(0), flags_(o.flags_) {
+        Link(o.Next());
+        Source(o.SourceOffset(), o.SourceLength());
+    }
+
+
+    /**
+     * Assignment operator, relative next element link is rebased to this element
+     *
+     * \param[in] o Element to copy
+     * \return this
+     */
+    JSONElement& operator=(const JSONElement& o) {
+        flags_ = o.flags_;
+        Link(o.Next());
+        Source(o.SourceOffset(), o.SourceLength());
+
+        return *this;
+    }
+#endif // GJSON_COMPACT_ELEMENTS
+
 
     /**
      * Get next JSON element
@@ -50,32 +89,61 @@ public:
      * \return JSON element or NULL
      */
     JSONElement* Next() const {
+#if GJSON_COMPACT_ELEMENTS
+        return e_ ? reinterpret_cast<JSONElement*>(reinterpret_cast<uintptr_t>(this) + static_cast<intptr_t>(e_)) : NULL;
+#else
         return e_;
+#endif // GJSON_COMPACT_ELEMENTS
     }
 
 
     /**
      * Set next JSON element
      *
+     * \note With \ref GJSON_COMPACT_ELEMENTS an element beyond 32 bit offset of this cannot be linked, next link 
+     * is cleared and NULL returned
+     *
      * \param[in] e Pointer to JSON element
-     * \return this
+     * \return this or NULL, link out of range
      */
     JSONElement* Next(JSONElement* e) {
         if (e) {
+#if GJSON_COMPACT_ELEMENTS
+            if (!Link(e)) {
+                return NULL;
+            }
+#else
             e_ = e;
+#endif // GJSON_COMPACT_ELEMENTS
         }
 
         return this;
     }
 
 
+    /**
+     * Clear next JSON element, element ends object chain.  \ref Next ignores NULL
+     */
+    void Unlink() {
+#if GJSON_COMPACT_ELEMENTS
+        e_ = 0;
+#else
+        e_ = NULL;
+#endif // GJSON_COMPACT_ELEMENTS
+    }
+
+
     /**
      * Get JSON element type
      *
      * \return See \ref TYPE
      */
     TYPE Type() {
+#if GJSON_COMPACT_ELEMENTS
+        return static_cast<TYPE>(flags_ & FLAG_TYPE);
+#else
         return static_cast<TYPE>(type_);
+#endif // GJSON_COMPACT_ELEMENTS
     }
 
 
@@ -86,14 +154,143 @@ public:
      * \return See \ref TYPE
      */
     TYPE Type(const TYPE type) {
+#if GJSON_COMPACT_ELEMENTS
+        flags_ = (flags_ & ~FLAG_TYPE) | type;
+#else
         type_ = type;
+#endif // GJSON_COMPACT_ELEMENTS
 
-        return static_cast<TYPE>(type_);
+        return Type();
+    }
+
+
+    /**
+     * Get source span offset, character index of token in JSON string element was parsed from
+     *
+     * \return Offset, 0 without \ref GJSON_SOURCE_SPANS
+     */
+    uint16_t SourceOffset() const {
+#if GJSON_SOURCE_SPANS
+        return so_;
+#else
+        return 0;
+#endif // GJSON_SOURCE_SPANS
+    }
+
+
+    /**
+     * Get source span length, characters of token in JSON string element was parsed from.  Quoted strings include 
+     * their quotes, arrays and maps are their one bracket character, packed numbers the whole array
+     *
+     * \return Length, 0 when dirty or without \ref GJSON_SOURCE_SPANS
+     */
+    uint16_t SourceLength() const {
+#if GJSON_SOURCE_SPANS
+        return sl_;
+#else
+        return 0;
+#endif // GJSON_SOURCE_SPANS
+    }
+
+
+    /**
+     * Set source span, see \ref JSONParse::FromString.  Without \ref GJSON_SOURCE_SPANS nothing
+     *
+     * \param[in] offset Character index of token
+     * \param[in] length Token length, characters.  0 none (dirty)
+     */
+    void Source(const uint16_t offset, const uint16_t length) {
+#if GJSON_SOURCE_SPANS
+        so_ = offset;
+        sl_ = length;
+#endif // GJSON_SOURCE_SPANS
+    }
+
+
+    /**
+     * Query element is dirty, changed since parsed or never parsed so no source span to copy
+     *
+     * \return Boolean, always true without \ref GJSON_SOURCE_SPANS
+     */
+    bool IsDirty() const {
+        return !SourceLength();
+    }
+
+
+    /**
+     * Mark element dirty, dropping its source span.  Setting string data does this, call after any other change 
+     * that alters how element is written
+     */
+    void Dirty() {
+        Source(0, 0);
     }
 
 protected:
+#if GJSON_COMPACT_ELEMENTS
+    /**
+     * Enum of header flags, packed with type
+     */
+    typedef enum {
+        FLAG_TYPE = 0x07,               ///< Type bits, \ref TYPE
+        FLAG_OPEN = 0x08,               ///< Array or map open
+        FLAG_VALUE = 0x10,              ///< String is value
+        FLAG_LITERAL = 0x20,            ///< String value is literal
+    }FLAG;
+
+
+    /**
+     * Get header flag
+     *
+     * \param[in] f Flag, \ref FLAG
+     * \return Boolean
+     */
+    bool Flag(const FLAG f) const {
+        return (flags_ & f) ? true : false;
+    }
+
+
+    /**
+     * Set header flag
+     *
+     * \param[in] f Flag, \ref FLAG
+     * \param[in] v Flag state
+     */
+    void Flag(const FLAG f, const bool v) {
+        flags_ = v ? (flags_ | f) : (flags_ & ~f);
+    }
+
+
+    /**
+     * Set next element link relative to this element.  Offset is taken on integer addresses, elements are 
+     * separate objects
+     *
+     * \param[in] e Pointer to JSON element or NULL (none)
+     * \retval true Success
+     * \retval false Failure, offset beyond 32 bits, link cleared
+     */
+    bool Link(const JSONElement* e) {
+        intptr_t d = e ? static_cast<intptr_t>(reinterpret_cast<uintptr_t>(e) - reinterpret_cast<uintptr_t>(this)) : 0;
+
+        e_ = static_cast<int32_t>(d);
+        if (static_cast<intptr_t>(e_) != d) {
+            e_ = 0;
+            return false;
+        }
+
+        return true;
+    }
+
+
+    int32_t         e_;                     ///< Next item, offset (Bytes) from this element, 0 none
+    uint8_t         flags_;                 ///< Element type and flags, \ref FLAG
+#else
     uint8_t            type_;            ///< Element type
     JSONElement*    e_;                  ///< Next item
+#endif // GJSON_COMPACT_ELEMENTS
+#if GJSON_SOURCE_SPANS
+    uint16_t        so_;                    ///< Source span offset
+    uint16_t        sl_;                    ///< Source span length, 0 dirty
+#endif // GJSON_SOURCE_SPANS
 }; // class JSONElement
 
 
@@ -114,8 +311,10 @@ public:
      * \param[in] is_value IsValue boolean, when true(default) indicates string is a value
      * \param[in] e Pointer, parent element or NULL (no parent yet)
      */
-    JSONString(const bool is_value=true, JSONElement<LENGTH>* e=NULL) : is_value_(is_value), length_(0), literal_(false) { // value change.  literal cannot be empty string
+    JSONString(const bool is_value=true, JSONElement<LENGTH>* e=NULL) : length_(0) { // value change.  literal cannot be empty string
         JSONElement<LENGTH>::Type(JSONElement<LENGTH>::STRING);
+        Value(is_value);
+        Literal(false);
         string_[0] = '\0';
         if (e) {
             e->Next(this);
@@ -132,8 +331,10 @@ public:
      * \param[in] is_value IsValue boolean, when true(default) indicates string is a value
      * \param[in] is_literal IsLiteral boolean, when true indicates string value is literal, default false
      */
-    JSONString(const char* s, const bool is_value=true, const bool is_literal=false) : is_value_(is_value), literal_(is_literal) { // str + value change
+    JSONString(const char* s, const bool is_value=true, const bool is_literal=false) { // str + value change
         JSONElement<LENGTH>::Type(JSONElement<LENGTH>::STRING);
+        Value(is_value);
+        Literal(is_literal);
         Data(s, is_literal);
     }
 
@@ -148,8 +349,10 @@ public:
      * \param[in] is_value IsValue boolean, when true(default) indicates string is a value
      * \param[in] is_literal IsLiteral boolean, when true indicates string value is literal, default false
      */
-    JSONString(const char* s, JSONElement<LENGTH>* e, const bool is_value=true, const bool is_literal=false) : is_value_(is_value), literal_(is_literal) { // str + value change + parent pointer
+    JSONString(const char* s, JSONElement<LENGTH>* e, const bool is_value=true, const bool is_literal=false) { // str + value change + parent pointer
         JSONElement<LENGTH>::Type(JSONElement<LENGTH>::STRING);
+        Value(is_value);
+        Literal(is_literal);
         Data(s, is_literal);
         if (e) {
             e->Next(this);
@@ -168,8 +371,10 @@ public:
      * \param[in] is_value IsValue boolean, when true(default) indicates string is a value
      * \param[in] is_literal IsLiteral boolean, when true indicates string value is literal, default false
      */
-    JSONString(const char* s, uint16_t l, JSONElement<LENGTH>* e, const bool is_value=true, const bool is_literal=false) : is_value_(is_value), literal_(is_literal) { // str + length + value change + parent pointer
+    JSONString(const char* s, uint16_t l, JSONElement<LENGTH>* e, const bool is_value=true, const bool is_literal=false) { // str + length + value change + parent pointer
         JSONElement<LENGTH>::Type(JSONElement<LENGTH>::STRING);
+        Value(is_value);
+        Literal(is_literal);
         Data(s, is_literal, l);
         if (e) {
             e->Next(this);
@@ -187,8 +392,9 @@ public:
      * \param[in] is_value IsValue boolean, when true(default) indicates string is a value
      * \param[in] prefer_literal Prefer Literal flag, indicates data string contains a JSON literal value, default true
      */
-    JSONString(const T d, const char* format, const bool is_value=true, const bool prefer_literal=true) : is_value_(is_value) { // str + value change
+    JSONString(const T d, const char* format, const bool is_value=true, const bool prefer_literal=true) { // str + value change
         JSONElement<LENGTH>::Type(JSONElement<LENGTH>::STRING);
+        Value(is_value);
         Data<T>(d, format, prefer_literal);
     }
 
@@ -204,8 +410,9 @@ public:
      * \param[in] is_value IsValue boolean, when true(default) indicates string is a value
      * \param[in] prefer_literal Prefer Literal flag, indicates data string contains a JSON literal value, default true
      */
-	JSONString(const T d, const char* format, JSONElement<LENGTH>* e, const bool is_value=true, const bool prefer_literal=true) : is_value_(is_value) { // str + value change + parent pointer
+	JSONString(const T d, const char* format, JSONElement<LENGTH>* e, const bool is_value=true, const bool prefer_literal=true) { // str + value change + parent pointer
         JSONElement<LENGTH>::Type(JSONElement<LENGTH>::STRING);
+        Value(is_value);
         Data<T>(d, format, prefer_literal);
         if (e) {
             e->Next(this);
@@ -234,6 +441,7 @@ public:
             if (length_ > l) {
                 string_[l] = '\0';
                 length_ = l;
+                JSONElement<LENGTH>::Dirty();
             }
         }
 
@@ -264,6 +472,7 @@ public:
 			length_ = 0;
 			string_[0] = '\0';
 		}
+        JSONElement<LENGTH>::Dirty();
 		
 		//		char yyy[32];
 
@@ -280,22 +489,22 @@ public:
 			memcpy(string_, yyy, length_);
 		}*/
 
-        if (is_value_) {
+        if (IsValue()) {
             if (prefer_literal) {
                 if (JSONSupport::IsLiteral(string_, length_, allow_exponent)) {
-                    literal_ = true;
+                    Literal(true);
                 }else {
                     r = false;    // Didn't get what you wanted
                 }
             }else {
                 // Value is quoted string
-                literal_ = false;
+                Literal(false);
             }
         }else {
             if (prefer_literal) {
                 r = false;    // Didn't get what you wanted
             }
-            literal_ = false;
+            Literal(false);
         }
 
 		return r;
@@ -318,13 +527,15 @@ public:
     bool Data(const char* d, const bool prefer_literal=false, const uint16_t length=0, const bool allow_exponent=GJSON_DEFAULT_EXPONENTIAL_NOTATION) {
         bool r = true;
 
+        JSONElement<LENGTH>::Dirty();
+
         if (!length) {
             uint8_t dl = strlen(d);
             uint8_t l = (dl<sizeof(string_) ? dl : (sizeof(string_)-1));
 
             string_[l] = '\0';
             length_ = l;
-            strncpy(string_, d, l);
+            memcpy(string_, d, l);
         }else {
             uint8_t l = (sizeof(string_)<length ? sizeof(string_)-1 : length);
 
@@ -334,28 +545,44 @@ public:
             length_ = l;
         }
 
-        if (is_value_) {
+        if (IsValue()) {
             if (prefer_literal) {
                 if (JSONSupport::IsLiteral(string_, length_, allow_exponent)) {
-                    literal_ = true;
+                    Literal(true);
                 }else {
                     r = false;    // Didn't get what you wanted
                 }
             }else {
                 // Value is quoted string
-                literal_ = false;
+                Literal(false);
             }
         }else {
             if (prefer_literal) {
                 r = false;    // Didn't get what you wanted
             }
-            literal_ = false;
+            Literal(false);
         }
 
         return r;
     } // Data(...)
 
 
+    /**
+     * Set string data from JSON string source, decoding escapes.  String is not literal
+     *
+     * \note Parser will use this method for quoted strings
+     *
+     * \param[in] d Pointer to JSON string source without enclosing quotes, not NULL terminated
+     * \param[in] length Source length, characters
+     */
+    void DataEscaped(const char* d, const uint16_t length) {
+        length_ = JSONSupport::Unescape(string_, sizeof(string_) - 1, d, length);
+        string_[length_] = '\0';
+        Literal(false);
+        JSONElement<LENGTH>::Dirty();
+    }
+
+
     /**
      * Get string data
      *
@@ -375,7 +602,11 @@ public:
      * \retval false Property/attribute
      */
     bool IsValue() const {
+#if GJSON_COMPACT_ELEMENTS
+        return JSONElement<LENGTH>::Flag(JSONElement<LENGTH>::FLAG_VALUE);
+#else
         return is_value_;
+#endif // GJSON_COMPACT_ELEMENTS
     }
 
 
@@ -386,7 +617,12 @@ public:
      * \return See \ref IsValue
      */
     bool Value(const bool is_value) {
+        JSONElement<LENGTH>::Dirty();
+#if GJSON_COMPACT_ELEMENTS
+        JSONElement<LENGTH>::Flag(JSONElement<LENGTH>::FLAG_VALUE, is_value);
+#else
         is_value_ = is_value;
+#endif // GJSON_COMPACT_ELEMENTS
 
         return IsValue();
     }
@@ -398,7 +634,11 @@ public:
      * \return Boolean
      */
     bool IsValueLiteral() const {
+#if GJSON_COMPACT_ELEMENTS
+        return JSONElement<LENGTH>::Flag(JSONElement<LENGTH>::FLAG_LITERAL);
+#else
         return literal_;
+#endif // GJSON_COMPACT_ELEMENTS
     }
 
 
@@ -410,7 +650,7 @@ public:
     bool IsNull() const {
         bool b = false;
 
-        if (is_value_ && literal_ && JSONSupport::IsNull(string_, length_)) {
+        if (IsValue() && IsValueLiteral() && JSONSupport::IsNull(string_, length_)) {
             b = true;
         }
 
@@ -430,7 +670,7 @@ public:
         }else {
             Data("null", true);
         }
-        literal_ = true;
+        Literal(true);
     }
 
 
@@ -442,7 +682,7 @@ public:
     bool IsBoolean() const {
         bool b = false;
 
-        if (is_value_ && literal_ && JSONSupport::IsBoolean(string_, length_)) {
+        if (IsValue() && IsValueLiteral() && JSONSupport::IsBoolean(string_, length_)) {
             b = true;
         }
 
@@ -470,7 +710,7 @@ public:
                 Data("false", true);
             }
         }
-        literal_ = true;
+        Literal(true);
     }
 
 
@@ -566,10 +806,26 @@ public:
     }
 
 protected:
+    /**
+     * Set string data value IsLiteral
+     *
+     * \param[in] literal Boolean indicating (true) value is literal
+     */
+    void Literal(const bool literal) {
+#if GJSON_COMPACT_ELEMENTS
+        JSONElement<LENGTH>::Flag(JSONElement<LENGTH>::FLAG_LITERAL, literal);
+#else
+        literal_ = literal;
+#endif // GJSON_COMPACT_ELEMENTS
+    }
+
+
     char            string_[LENGTH];        ///< String
     uint16_t        length_;                ///< String length
+#if !GJSON_COMPACT_ELEMENTS
     bool            is_value_;              ///< Is value or key
     bool            literal_;               ///< Value is literal
+#endif // !GJSON_COMPACT_ELEMENTS
 }; // JSONString
 
 
@@ -589,8 +845,9 @@ public:
      * \param[in] e Pointer, parent element or NULL (no parent yet)
      * \param[in] is_open IsOpen boolean, when true(default) indicates opening (start)
      */
-    JSONArray(JSONElement<LENGTH>* e=NULL, const bool is_open=true) : JSONElement<LENGTH>(e), is_open_(is_open) {    // e before is_open because close will always refer to an e instance
+    JSONArray(JSONElement<LENGTH>* e=NULL, const bool is_open=true) : JSONElement<LENGTH>(e) {    // e before is_open because close will always refer to an e instance
         JSONElement<LENGTH>::Type(JSONElement<LENGTH>::ARRAY);
+        Open(is_open);
     }
 
 
@@ -599,8 +856,9 @@ public:
      *
      * \param[in] is_open IsOpen boolean, when true(default) indicates array opening (start)
      */
-    JSONArray(const bool is_open) : JSONElement<LENGTH>(NULL), is_open_(is_open) {
+    JSONArray(const bool is_open) : JSONElement<LENGTH>(NULL) {
         JSONElement<LENGTH>::Type(JSONElement<LENGTH>::ARRAY);
+        Open(is_open);
     }
 
 
@@ -610,7 +868,11 @@ public:
      * \return Boolean
      */
     bool IsOpen() const {
+#if GJSON_COMPACT_ELEMENTS
+        return JSONElement<LENGTH>::Flag(JSONElement<LENGTH>::FLAG_OPEN);
+#else
         return is_open_;
+#endif // GJSON_COMPACT_ELEMENTS
     }
 
 
@@ -621,13 +883,20 @@ public:
      * \return Boolean, see \ref IsOpen
      */
     bool Open(const bool is_open) {
+        JSONElement<LENGTH>::Dirty();
+#if GJSON_COMPACT_ELEMENTS
+        JSONElement<LENGTH>::Flag(JSONElement<LENGTH>::FLAG_OPEN, is_open);
+#else
         is_open_ = is_open;
+#endif // GJSON_COMPACT_ELEMENTS
 
         return IsOpen();
     }
 
+#if !GJSON_COMPACT_ELEMENTS
 protected:
     bool            is_open_;               ///< Is Open
+#endif // !GJSON_COMPACT_ELEMENTS
 }; // class JSONArray
 
 
@@ -648,6 +917,545 @@ public:
     }
 }; // class JSONMap
 
+
+/**
+ * A class representing a JSON in-memory packed array of numbers.  An array of only numeric literals held as one 
+ * element with a vector of 32 or 64 bit integers or single or double precision decimals, in place of array open, 
+ * string per number and array close
+ *
+ * \note Element refers to number storage, it doesn't hold it.  \ref JSONParse::Release releases storage by 
+ * \ref GJSON_RELEASE_ARRAY
+ *
+ * \tparam LENGTH Maximum length (including NULL terminator) in characters of a string attribute/property
+ */
+template<uint8_t LENGTH>
+class JSONNumbers : public JSONElement<LENGTH> {
+public:
+    /**
+     * Enum of number kinds
+     */
+    typedef enum {
+        INT32 = 0,                      ///< int32_t
+        INT64,                          ///< int64_t
+        FLOAT,                          ///< float
+        DOUBLE,                         ///< double
+    }KIND;
+
+
+    /**
+     * Constructor, make stable instance of number storage and optionally parent in-memory element
+     *
+     * \note If parent specified then its next element pointer will be updated with this
+     *
+     * \param[in] kind Number kind, \ref KIND
+     * \param[in] data Pointer to number storage of kind
+     * \param[in] count Number of numbers
+     * \param[in] e Pointer, parent element or NULL (no parent yet)
+     */
+    JSONNumbers(const KIND kind, void* data, const uint16_t count, JSONElement<LENGTH>* e=NULL) : JSONElement<LENGTH>(e), 
+                                data_(data), count_(count), kind_(kind) {
+        JSONElement<LENGTH>::Type(JSONElement<LENGTH>::NUMBERS);
+    }
+
+
+    /**
+     * Get number kind
+     *
+     * \return See \ref KIND
+     */
+    KIND Kind() const {
+        return static_cast<KIND>(kind_);
+    }
+
+
+    /**
+     * Get number of numbers
+     *
+     * \return Count
+     */
+    uint16_t Count() const {
+        return count_;
+    }
+
+
+    /**
+     * Get number storage
+     *
+     * \return Pointer to storage
+     */
+    void* Data() const {
+        return data_;
+    }
+
+
+    /**
+     * Get 32 bit integer storage
+     *
+     * \return Pointer to numbers or NULL, other kind
+     */
+    int32_t* Int32() const {
+        return (INT32 == kind_) ? static_cast<int32_t*>(data_) : NULL;
+    }
+
+
+    /**
+     * Get 64 bit integer storage
+     *
+     * \return Pointer to numbers or NULL, other kind
+     */
+    int64_t* Int64() const {
+        return (INT64 == kind_) ? static_cast<int64_t*>(data_) : NULL;
+    }
+
+
+    /**
+     * Get single precision decimal storage
+     *
+     * \return Pointer to numbers or NULL, other kind
+     */
+    float* Float() const {
+        return (FLOAT == kind_) ? static_cast<float*>(data_) : NULL;
+    }
+
+
+    /**
+     * Get double precision decimal storage
+     *
+     * \return Pointer to numbers or NULL, other kind
+     */
+    double* Double() const {
+        return (DOUBLE == kind_) ? static_cast<double*>(data_) : NULL;
+    }
+
+
+    /**
+     * Get number of any kind as decimal
+     *
+     * \attention 64 bit integers beyond 53 bits lose precision
+     *
+     * \param[in] i Index
+     * \return Number, 0 when index out of range
+     */
+    double Get(const uint16_t i) const {
+        if (i >= count_) {
+            return 0;
+        }
+        switch(kind_) {
+            case INT32 : return static_cast<const int32_t*>(data_)[i];
+            case INT64 : return static_cast<double>(static_cast<const int64_t*>(data_)[i]);
+            case FLOAT : return static_cast<const float*>(data_)[i];
+            default : return static_cast<const double*>(data_)[i];
+        }
+    }
+
+
+    /**
+     * Get size of one number of kind
+     *
+     * \param[in] kind Number kind, \ref KIND
+     * \return Bytes
+     */
+    static uint8_t Size(const KIND kind) {
+        switch(kind) {
+            case INT32 : return sizeof(int32_t);
+            case INT64 : return sizeof(int64_t);
+            case FLOAT : return sizeof(float);
+            default : return sizeof(double);
+        }
+    }
+
+protected:
+    void*           data_;                  ///< Number storage
+    uint16_t        count_;                 ///< Number of numbers
+    uint8_t         kind_;                  ///< Number kind, \ref KIND
+}; // class JSONNumbers
+
+
+/**
+ * A class representing a JSON in-memory interned attribute/property element.  String is held once by a \ref JSONIntern 
+ * table shared by the object chain, the element holding only its table identifier
+ *
+ * \tparam LENGTH Maximum length (including NULL terminator) in characters of a string attribute/property
+ */
+template<uint8_t LENGTH>
+class JSONKey : public JSONElement<LENGTH> {
+public:
+    /**
+     * Constructor, make stable instance with table identifier and optionally parent in-memory element
+     *
+     * \note If parent specified then its next element pointer will be updated with this
+     *
+     * \param[in] id Intern table identifier
+     * \param[in] e Pointer, parent element or NULL (no parent yet)
+     */
+    JSONKey(const uint16_t id, JSONElement<LENGTH>* e=NULL) : JSONElement<LENGTH>(e), id_(id) {
+        JSONElement<LENGTH>::Type(JSONElement<LENGTH>::KEY);
+    }
+
+
+    /**
+     * Get intern table identifier
+     *
+     * \return Identifier
+     */
+    uint16_t Id() const {
+        return id_;
+    }
+
+protected:
+    uint16_t        id_;                    ///< Intern table identifier
+}; // class JSONKey
+
+
+/**
+ * A class representing a JSON in-memory raw element, JSON text already serialized (a cached sub-document or one 
+ * forwarded from upstream) written verbatim by \ref JSONParse::FromObject in place of the elements it would parse into.
+ *
+ * Text is normally one complete value but may be part of one, e.g. "{\"id\":1,\"data\":[" with another raw of "]}" 
+ * after it.  Net array and map opens of text are counted at construction, quote aware, so node level of object chain 
+ * still balances, and whether text begins and ends an item so commas are placed around it as any other element.
+ *
+ * \attention Element refers to text, it doesn't hold it.  Keep text unchanged while element is in use
+ *
+ * \note No callbacks are made for raw elements, \ref JSONPath treats one as a single value
+ *
+ * \tparam LENGTH Maximum length (including NULL terminator) in characters of a string attribute/property
+ */
+template<uint8_t LENGTH>
+class JSONRaw : public JSONElement<LENGTH> {
+public:
+    /**
+     * Constructor, make stable instance of JSON text and optionally parent in-memory element
+     *
+     * \note If parent specified then its next element pointer will be updated with this
+     *
+     * \param[in] s Pointer to JSON text, a span of a JSON string or buffer, need not be NULL terminated
+     * \param[in] l Text length, characters
+     * \param[in] e Pointer, parent element or NULL (no parent yet)
+     */
+    JSONRaw(const char* s, const uint16_t l, JSONElement<LENGTH>* e=NULL) : JSONElement<LENGTH>(e), data_(s), length_(l), 
+                                arrays_(0), maps_(0), item_(0) {
+        JSONElement<LENGTH>::Type(JSONElement<LENGTH>::RAW);
+        Account();
+    }
+
+
+    /**
+     * Constructor, make stable instance of JSON text and optionally parent in-memory element
+     *
+     * \note If parent specified then its next element pointer will be updated with this
+     *
+     * \param[in] s Pointer to JSON text, NULL terminated
+     * \param[in] e Pointer, parent element or NULL (no parent yet)
+     */
+    JSONRaw(const char* s, JSONElement<LENGTH>* e=NULL) : JSONElement<LENGTH>(e), data_(s), length_(strlen(s)), 
+                                arrays_(0), maps_(0), item_(0) {
+        JSONElement<LENGTH>::Type(JSONElement<LENGTH>::RAW);
+        Account();
+    }
+
+
+    /**
+     * Get JSON text
+     *
+     * \return Pointer to text, not NULL terminated
+     */
+    const char* Data() const {
+        return data_;
+    }
+
+
+    /**
+     * Get JSON text length
+     *
+     * \return Length, characters
+     */
+    uint16_t Length() const {
+        return length_;
+    }
+
+
+    /**
+     * Get net array opens of text
+     *
+     * \return Opens less closes, 0 when balanced
+     */
+    int16_t Arrays() const {
+        return arrays_;
+    }
+
+
+    /**
+     * Get net map opens of text
+     *
+     * \return Opens less closes, 0 when balanced
+     */
+    int16_t Maps() const {
+        return maps_;
+    }
+
+
+    /**
+     * Query text begins an item, so is comma separated from a value before
+     *
+     * \return Boolean
+     */
+    bool IsItemStart() const {
+        return (item_ & ITEM_START) ? true : false;
+    }
+
+
+    /**
+     * Query text ends an item, so is comma separated from an item after
+     *
+     * \return Boolean
+     */
+    bool IsItemEnd() const {
+        return (item_ & ITEM_END) ? true : false;
+    }
+
+protected:
+    /**
+     * Enum of item flags
+     */
+    typedef enum {
+        ITEM_START = 0x01,              ///< Text begins an item
+        ITEM_END = 0x02,                ///< Text ends an item
+    }ITEM;
+
+
+    /**
+     * Count net array and map opens of text and whether it begins and ends an item.  Brackets of quoted strings 
+     * are ignored
+     */
+    void Account() {
+        uint16_t i;
+        char f = 0, c = 0;
+        bool q = false;
+
+        for(i=0; i<length_; i++) {
+            char ch = data_[i];
+
+            if (q) {
+                if ('\\' == ch) {
+                    i++;
+                }else if ('\"' == ch) {
+                    q = false;
+                }
+                continue;
+            }
+            switch(ch) {
+                case ' ' : case '\t' : case '\r' : case '\n' :
+                continue;
+
+                case '\"' : q = true; break;
+                case '[' : arrays_++; break;
+                case ']' : arrays_--; break;
+                case '{' : maps_++; break;
+                case '}' : maps_--; break;
+                default : break;
+            }
+            if (!f) {
+                f = ch;
+            }
+            c = ch;
+        }
+        if (f && ']' != f && '}' != f && ',' != f && ':' != f) {
+            item_ |= ITEM_START;
+        }
+        if (c && '[' != c && '{' != c && ',' != c && ':' != c) {
+            item_ |= ITEM_END;
+        }
+    } // Account(...)
+
+
+    const char*     data_;                  ///< JSON text
+    uint16_t        length_;                ///< Text length, characters
+    int16_t         arrays_;                ///< Net array opens
+    int16_t         maps_;                  ///< Net map opens
+    uint8_t         item_;                  ///< Item flags, \ref ITEM
+}; // class JSONRaw
+
+
+/**
+ * Attribute/property intern table.  Parsing arrays of alike maps repeats the same attribute/properties many times, 
+ * with a table given to the parser each distinct attribute/property string is held once and object chain holds 
+ * \ref JSONKey elements of its identifier.  Storage is given by subclass, see \ref JSONInternBuffer
+ *
+ * \attention Keep table and its content while object chain referring to it is in use, \ref Clear only when no 
+ * object chain refers to it
+ *
+ * \tparam LENGTH Maximum length (including NULL terminator) in characters of a string attribute/property
+ */
+template<uint8_t LENGTH>
+class JSONIntern {
+public:
+    static const uint16_t NONE = 0xffff;    ///< Identifier of no string
+
+
+    /**
+     * Find string
+     *
+     * \param[in] s String, need not be NULL terminated
+     * \param[in] l String length (characters)
+     * \return Identifier or \ref NONE (not held)
+     */
+    uint16_t Find(const char* s, const uint16_t l) const {
+        for(uint16_t id=0; id<count_; id++) {
+            if (lengths_[id] == l && !memcmp(keys_[id], s, l)) {
+                return id;
+            }
+        }
+
+        return NONE;
+    } // Find(...)
+
+
+    /**
+     * Find string adding it when not held
+     *
+     * \param[in] s String, need not be NULL terminated
+     * \param[in] l String length (characters)
+     * \return Identifier or \ref NONE (table full or string too long)
+     */
+    uint16_t Intern(const char* s, const uint16_t l) {
+        uint16_t id = Find(s, l);
+
+        if (NONE == id && count_ < max_ && l < LENGTH) {
+            id = count_++;
+            memcpy(keys_[id], s, l);
+            keys_[id][l] = '\0';
+            lengths_[id] = l;
+        }
+
+        return id;
+    } // Intern(...)
+
+
+    /**
+     * Get string
+     *
+     * \param[in] id Identifier
+     * \return NULL terminated string or NULL (unknown identifier)
+     */
+    const char* Data(const uint16_t id) const {
+        return (id < count_) ? keys_[id] : NULL;
+    }
+
+
+    /**
+     * Get string length
+     *
+     * \param[in] id Identifier
+     * \return Length (characters), 0 unknown identifier
+     */
+    uint8_t Length(const uint16_t id) const {
+        return (id < count_) ? lengths_[id] : 0;
+    }
+
+
+    /**
+     * Copy string into attribute/property string element, for callbacks and users wanting a \ref JSONString
+     *
+     * \param[in] id Identifier
+     * \param[out] s Pointer to string element
+     * \retval true Success
+     * \retval false Failure, unknown identifier
+     */
+    bool Key(const uint16_t id, JSONString<LENGTH>* s) const {
+        s->Value(false);
+
+        return (id < count_) ? s->Data(keys_[id], false, lengths_[id]) : false;
+    }
+
+
+    /**
+     * Get number of strings held
+     *
+     * \return Count
+     */
+    uint16_t Count() const {
+        return count_;
+    }
+
+
+    /**
+     * Empty table
+     */
+    void Clear() {
+        count_ = 0;
+    }
+
+
+    /**
+     * Mark strings matching search string as \ref JSONParse::FindString compares attribute/properties.  Searching then 
+     * tests a mark per element rather than comparing strings
+     *
+     * \param[in] like Search string
+     * \param[in] n Search string length (characters), 0 marks all
+     * \param[in] case_sensitive Flag indicating comparison should be case sensitive
+     */
+    void Mark(const char* like, const uint16_t n, const bool case_sensitive) {
+        memset(marks_, 0, (max_ + 7) / 8);
+        for(uint16_t id=0; id<count_; id++) {
+            if (!n || (case_sensitive ? GJSON_REPLACE_STRNCMP(like, keys_[id], n) : GJSON_REPLACE_STRNCMPI(like, keys_[id], n)) >= 0) {
+                marks_[id >> 3] |= (1 << (id & 7));
+            }
+        }
+    } // Mark(...)
+
+
+    /**
+     * Query string mark, see \ref Mark
+     *
+     * \param[in] id Identifier
+     * \return Boolean
+     */
+    bool IsMarked(const uint16_t id) const {
+        return (id < count_) && (marks_[id >> 3] & (1 << (id & 7)));
+    }
+
+protected:
+    /**
+     * Constructor, make stable instance of given storage
+     *
+     * \param[in] keys Pointer to string storage, max strings of LENGTH characters
+     * \param[in] lengths Pointer to string length storage, max lengths
+     * \param[in] marks Pointer to mark storage, (max + 7) / 8 Bytes
+     * \param[in] max Maximum number of strings
+     */
+    JSONIntern(char (*keys)[LENGTH], uint8_t* lengths, uint8_t* marks, const uint16_t max) : keys_(keys), lengths_(lengths), 
+                                marks_(marks), max_((max < NONE) ? max : NONE - 1), count_(0) { }
+
+
+    char            (*keys_)[LENGTH];       ///< Strings
+    uint8_t*        lengths_;               ///< String lengths
+    uint8_t*        marks_;                 ///< String marks, bit per string
+    uint16_t        max_;                   ///< Maximum number of strings
+    uint16_t        count_;                 ///< Number of strings held
+}; // class JSONIntern
+
+
+/**
+ * Attribute/property intern table with its own storage
+ *
+ * \tparam LENGTH Maximum length (including NULL terminator) in characters of a string attribute/property
+ * \tparam KEYS Maximum number of distinct attribute/properties
+ */
+template<uint8_t LENGTH, uint16_t KEYS>
+class JSONInternBuffer : public JSONIntern<LENGTH> {
+public:
+    /**
+     * Constructor, make stable instance
+     */
+    JSONInternBuffer() : JSONIntern<LENGTH>(keys_, lengths_, marks_, KEYS) { }
+
+protected:
+    char            keys_[KEYS][LENGTH];    ///< String storage
+    uint8_t         lengths_[KEYS];         ///< String length storage
+    uint8_t         marks_[(KEYS + 7) / 8]; ///< Mark storage
+}; // class JSONInternBuffer
+
 }; // namespace gjson
 
 #endif // GJSON_ELEMENTS_H
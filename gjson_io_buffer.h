@@ -87,6 +87,45 @@ public:
     virtual bool Append(const char* s) = 0;
 
 
+    /**
+     * Append given number of characters, string need not be NULL terminated.  Override where
+     * storage allows a block copy
+     *
+     * \attention No character data will be appended upon failure, it is all or nothing
+     *
+     * \param[in] s Pointer to characters for append
+     * \param[in] n Number of characters
+     * \retval true Success
+     * \retval false Failure, buffer full
+     */
+    virtual bool Append(const char* s, const uint16_t n) {
+        uint16_t l = GetLength();
+        bool wr_err = false;
+
+        for(uint16_t i=0; i<n && !wr_err; i++) {
+            wr_err |= Append(s[i]);
+        }
+        if (wr_err) {
+            Length(l);
+        }
+
+        return wr_err;
+    }
+
+
+    /**
+     * Helper, append NULL terminated string with JSON string escapes.  Runs needing no escape
+     * are appended as blocks
+     *
+     * \param[in] s Pointer to NULL termined string for append
+     * \retval true Success
+     * \retval false Failure, buffer full
+     */
+    bool AppendEscaped(const char* s) {
+        return JSONSupport::AppendEscaped(this, s);
+    }
+
+
     /**
      * Helper, replace string content between start and end indexes with given string
      *
@@ -201,6 +240,22 @@ public:
     }
 
 
+    /**
+     * Append given number of characters
+     *
+     * \attention Ignore parameters for NULL I/O
+     *
+     * \param[in] s Pointer to characters for append
+     * \param[in] n Number of characters
+     * \retval false Always success (there is no I/O)
+     */
+    bool Append(const char* s, const uint16_t n) {
+        (void)s;
+        (void)n;
+        return false;
+    }
+
+
     /**
      * Helper, replace string content between start and end indexes with given string
      *
@@ -312,6 +367,19 @@ public:
     }
 
 
+    bool Append(const char* s, const uint16_t n) {
+        bool wr_err = true;
+
+        if ((length_ + n) < max_length_) {
+            wr_err = false;
+            memcpy(&buffer_[length_], s, n);
+            length_ += n;
+        }
+
+        return wr_err;
+    }
+
+
     bool Replace(const char* s, uint16_t sp, uint16_t ep) {
         // Implementation optional, used if output buffer also input and updates desired (string manipulation) rather than objects
         bool r = true;
@@ -331,6 +399,113 @@ protected:
 }; // class UserBuffer
 
 
+/**
+ * User specified buffer I/O without virtual methods.  Same interface as \ref UserBuffer but not an \ref IO, for use as
+ * I/O type of JSONParse where all buffer access is then direct and may inline, e.g. JSONParse<LENGTH, void, UserSpan>
+ *
+ * \attention Character access by index is not bounds checked
+ */
+class UserSpan {
+public:
+    /**
+     * Constructor, make stable instance.  Take user buffer details, string pointer, string length and buffer length
+     *
+     * \attention The given string used for buffering must exist for the entire life of related parser instance
+     *
+     * \param[in] s Pointer to source NULL terminated string buffer for parser I/O
+     * \param[in] ml Maximum buffer length (characters, including NULL terminator)
+     * \param[in] l Current string length in buffer, if any, default 0 characters
+     */
+    UserSpan(char *s, uint16_t ml, uint16_t l=0) : max_length_(ml), length_(l), buffer_(s) {
+        buffer_[l] = '\0'; // Make sure input buffer is NULL terminated
+    }
+
+
+    const char* Get() const {
+        return buffer_;
+    }
+
+
+    char Get(uint16_t i) const {
+        return buffer_[i];
+    }
+
+
+    uint16_t GetLength(const bool maximum=false) const {
+        return maximum ? max_length_ : length_;
+    }
+
+
+    void Length(const uint16_t length) {
+        length_ = length;
+    }
+
+
+    bool Put(uint16_t i, char v) {
+        bool wr_err = true;
+
+        if (i<length_) {
+            wr_err = false;
+            buffer_[i] = v;
+        }
+
+        return wr_err;
+    }
+
+
+    bool Append(char v) {
+        bool wr_err = true;
+
+        if (length_ < max_length_) {
+            wr_err = false;
+            buffer_[length_++] = v;
+        }
+
+        return wr_err;
+    }
+
+
+    bool Append(const char* s) {
+        return Append(s, strlen(s));
+    }
+
+
+    bool Append(const char* s, const uint16_t n) {
+        bool wr_err = true;
+
+        if ((length_ + n) < max_length_) {
+            wr_err = false;
+            memcpy(&buffer_[length_], s, n);
+            length_ += n;
+        }
+
+        return wr_err;
+    }
+
+
+    bool AppendEscaped(const char* s) {
+        return JSONSupport::AppendEscaped(this, s);
+    }
+
+
+    bool Replace(const char* s, uint16_t sp, uint16_t ep) {
+        bool r = true;
+
+        if (sp<length_ && ep<=length_) {
+            length_ = JSONSupport::Replace(&buffer_[0], length_, max_length_, sp, ep, s, strlen(s));
+            r = false;
+        }
+
+        return r;
+    }
+
+protected:
+    uint16_t    max_length_;                ///< Maximum buffer length, Characters
+    uint16_t    length_;                    ///< Length of buffer, Characters.  Has to be less than equal to \ref max_length_
+    char        *buffer_;                   ///< Character buffer pointer
+}; // class UserSpan
+
+
 /**
  * An class for an internally managed character buffer when JSON parsing.  Use this in situations where you require some 
  * storage for JSON, when data may get changed and there is no user string to be reused.
@@ -418,6 +593,19 @@ public:
     }
 
 
+    bool Append(const char* s, const uint16_t n) {
+        bool wr_err = true;
+
+        if ((length_ + n) < sizeof(buffer_)) {
+            wr_err = false;
+            memcpy(&buffer_[length_], s, n);
+            length_ += n;
+        }
+
+        return wr_err;
+    }
+
+
     bool Replace(const char* s, uint16_t sp, uint16_t ep) {
         // Implementation optional, used if output buffer also input and updates desired (string manipulation) rather than objects
         bool r = true;
@@ -0,0 +1,358 @@
+/**
+ * \file
+ * Embedded JSON builder and parser - On demand document
+ * PROJECT: GJSON library
+ * TARGET SYSTEM: Arduino, STM32, Atmel AT91SAM, portable
+ */
+
+#ifndef GJSON_LAZY_H
+#define GJSON_LAZY_H
+
+namespace gjson {
+
+/**
+ * On demand document over JSON string held by user supplied I/O.  Only the root value is indexed up front, the
+ * children of an array or map are indexed the first time it is navigated into, by \ref Member, \ref Element or
+ * \ref Count, and kept for later navigation.  Indexing a container records the span of each child, grandchildren are
+ * skipped by quote and bracket matching as \ref JSONPointer does, so cost follows what is looked at rather than
+ * document size.
+ *
+ * Values are decoded into a caller's string element by \ref Value, or a subtree built into an object chain by
+ * \ref Materialize when element access is wanted.
+ *
+ *   JSONLazy<16> doc(&io);
+ *   JSONLazy<16>::Node n = doc.Member(doc.Member(doc.Root(), "config"), "port");
+ *   doc.Value(n, &s);
+ *
+ * \attention Nodes refer to JSON string of I/O, keep it unchanged while document is in use.  \ref Root starts afresh
+ *
+ * \note Navigation from \ref NONE gives \ref NONE so lookups may be chained, check \ref GetLastError at the end.  Each 
+ * navigation starts with error cleared, a failed lookup does not stop later ones
+ *
+ * \tparam LENGTH Maximum length (including NULL terminator) in characters of a string attribute/property
+ * \tparam NODES Maximum number of indexed values.  Default 32
+ */
+template<uint8_t LENGTH, uint16_t NODES=32>
+class JSONLazy : public JSONPointer {
+public:
+    typedef uint16_t Node;                  ///< Node, index of indexed value
+    static const Node NONE = 0xffff;        ///< No node
+
+
+    /**
+     * Constructor, make stable instance with given I/O instance
+     *
+     * \param[in] io Pointer to I/O instance, source of JSON string
+     */
+    JSONLazy(IO* io) : JSONPointer(io), count_(0) { }
+
+
+    /**
+     * \copydoc JSONPointer::GetSpan
+     */
+    using JSONPointer::GetSpan;
+
+
+    /**
+     * Index root value of JSON string of I/O, discarding any nodes indexed before
+     *
+     * \return Root node or \ref NONE, check \ref GetLastError
+     */
+    Node Root() {
+        const char* s = io_->Get();
+        uint16_t l = io_->GetLength();
+        uint16_t i = SkipWhiteSpace(s, 0, l);
+
+        count_ = 0;
+        last_error_ = ERR_NONE;
+
+        return Index(s, i, SkipValue(s, i, l), NONE);
+    } // Root(...)
+
+
+    /**
+     * Get map member, indexing map when first navigated into
+     *
+     * \note Attribute/property is compared character for character with JSON string, escapes are not decoded
+     *
+     * \param[in] n Map node
+     * \param[in] key Attribute/property, NULL terminated
+     * \return Member value node or \ref NONE, check \ref GetLastError (ERR_NOT_FOUND absent)
+     */
+    Node Member(const Node n, const char* key) {
+        uint16_t kl = strlen(key), c;
+
+        last_error_ = ERR_NONE;
+        if (!Expand(n, JSONElement<LENGTH>::MAP)) {
+            return NONE;
+        }
+        for(c=nodes_[n].first; c<nodes_[n].first + nodes_[n].count; c++) {
+            const JSONSpan& k = nodes_[c].key;
+
+            if (k.length == kl + 2 && !memcmp(&io_->Get()[k.offset + 1], key, kl)) {
+                return c;
+            }
+        }
+        last_error_ = ERR_NOT_FOUND;
+
+        return NONE;
+    } // Member(...)
+
+
+    /**
+     * Get array element, indexing array when first navigated into
+     *
+     * \param[in] n Array node
+     * \param[in] index Element index
+     * \return Element value node or \ref NONE, check \ref GetLastError (ERR_NOT_FOUND beyond end)
+     */
+    Node Element(const Node n, const uint16_t index) {
+        last_error_ = ERR_NONE;
+        if (!Expand(n, JSONElement<LENGTH>::ARRAY)) {
+            return NONE;
+        }
+        if (index >= nodes_[n].count) {
+            last_error_ = ERR_NOT_FOUND;
+            return NONE;
+        }
+
+        return nodes_[n].first + index;
+    } // Element(...)
+
+
+    /**
+     * Get number of array elements or map members, indexing container when first navigated into
+     *
+     * \param[in] n Array or map node
+     * \return Count, 0 also when not a container
+     */
+    uint16_t Count(const Node n) {
+        last_error_ = ERR_NONE;
+
+        return Expand(n, JSONElement<LENGTH>::NOTSET) ? nodes_[n].count : 0;
+    }
+
+
+    /**
+     * Get node type
+     *
+     * \param[in] n Node
+     * \return ARRAY, MAP or STRING (any other value).  NOTSET for \ref NONE
+     */
+    typename JSONElement<LENGTH>::TYPE Type(const Node n) const {
+        return (n < count_) ? static_cast<typename JSONElement<LENGTH>::TYPE>(nodes_[n].type) : JSONElement<LENGTH>::NOTSET;
+    }
+
+
+    /**
+     * Get span of node value within JSON string
+     *
+     * \param[in] n Node
+     * \return Span, empty for \ref NONE
+     */
+    JSONSpan GetSpan(const Node n) const {
+        return (n < count_) ? nodes_[n].value : JSONSpan();
+    }
+
+
+    /**
+     * Decode map member attribute/property into string element
+     *
+     * \param[in] n Member value node
+     * \param[out] e Pointer to string element, set as attribute/property
+     * \retval true Success
+     * \retval false Failure, not a map member
+     */
+    bool Key(const Node n, JSONString<LENGTH>* e) const {
+        if (n >= count_ || !nodes_[n].key.length) {
+            return false;
+        }
+        e->Value(false);
+        e->DataEscaped(&io_->Get()[nodes_[n].key.offset + 1], nodes_[n].key.length - 2);
+
+        return true;
+    } // Key(...)
+
+
+    /**
+     * Decode string or literal value into string element, escapes of quoted strings decoded
+     *
+     * \param[in] n Value node
+     * \param[out] e Pointer to string element, set as value
+     * \retval true Success
+     * \retval false Failure, array, map or bad literal
+     */
+    bool Value(const Node n, JSONString<LENGTH>* e) const {
+        const char* s;
+
+        if (JSONElement<LENGTH>::STRING != Type(n)) {
+            return false;
+        }
+        s = &io_->Get()[nodes_[n].value.offset];
+        e->Value(true);
+        if ('\"' == s[0]) {
+            e->DataEscaped(s + 1, nodes_[n].value.length - 2);
+
+            return true;
+        }
+
+        return e->Data(s, true, nodes_[n].value.length);
+    } // Value(...)
+
+
+    /**
+     * Build object chain of array or map node subtree by given parser, element access to just that subtree
+     *
+     * \attention Caller should release object chain via parser \ref JSONParse::Release
+     *
+     * \tparam P Parser type, a \ref JSONParse of same LENGTH given I/O of this document
+     * \param[in] n Array or map node
+     * \param[in,out] pr Pointer to parser
+     * \param[out] h Pointer to pointer of JSON element to take object chain
+     * \retval true Success
+     * \retval false Failure, not a container or parse error, see parser \ref JSONParse::GetLastError
+     */
+    template<class P>
+    bool Materialize(const Node n, P* pr, JSONElement<LENGTH>** h) {
+        if (JSONElement<LENGTH>::ARRAY != Type(n) && JSONElement<LENGTH>::MAP != Type(n)) {
+            last_error_ = ERR_BAD_VALUE;
+            return false;
+        }
+        pr->LimitNodeLevel(true);
+        pr->FromString(const_cast<char*>(io_->Get()), h, nodes_[n].value.offset);
+        last_error_ = pr->GetLastError();
+
+        return (ERR_NONE == last_error_);
+    } // Materialize(...)
+
+
+    /**
+     * Get number of nodes indexed
+     *
+     * \return Nodes
+     */
+    uint16_t GetNodes() const {
+        return count_;
+    }
+
+protected:
+    /**
+     * Indexed value
+     */
+    typedef struct {
+        JSONSpan    value;                  ///< Value span
+        JSONSpan    key;                    ///< Attribute/property span including quotes, empty when not map member
+        uint16_t    first;                  ///< Node of first child, array and map when expanded
+        uint16_t    count;                  ///< Number of children, array and map when expanded
+        uint8_t     type;                   ///< Element type, ARRAY, MAP or STRING
+        bool        expanded;               ///< Children indexed flag
+    }Entry;
+
+
+    /**
+     * Index value as node
+     *
+     * \param[in] s JSON string
+     * \param[in] i Character index of value
+     * \param[in] ei Character index after value
+     * \param[in] ki Character index of attribute/property opening quote or NONE (not map member)
+     * \return Node or \ref NONE, pool full or error
+     */
+    Node Index(const char* s, const uint16_t i, const uint16_t ei, const uint16_t ki) {
+        if (ERR_NONE != last_error_) {
+            return NONE;
+        }
+        if (count_ >= NODES) {
+            last_error_ = ERR_OBJECT_MEMORY_LIMIT;
+            return NONE;
+        }
+
+        Entry& e = nodes_[count_];
+
+        e.value.offset = i;
+        e.value.length = ei - i;
+        e.key.Clear();
+        if (NONE != ki) {
+            e.key.offset = ki;
+            e.key.length = SkipString(s, ki, ei) - ki;
+        }
+        e.type = ('{' == s[i]) ? JSONElement<LENGTH>::MAP : (('[' == s[i]) ? JSONElement<LENGTH>::ARRAY : JSONElement<LENGTH>::STRING);
+        e.first = e.count = 0;
+        e.expanded = false;
+
+        return count_++;
+    } // Index(...)
+
+
+    /**
+     * Index children of array or map node, once
+     *
+     * \param[in] n Node
+     * \param[in] type Container type wanted, NOTSET either
+     * \retval true Success
+     * \retval false Failure, check \ref GetLastError
+     */
+    bool Expand(const Node n, const typename JSONElement<LENGTH>::TYPE type) {
+        const char* s = io_->Get();
+        uint16_t l, i, first = count_;
+        bool is_map;
+
+        if (n >= count_ || (JSONElement<LENGTH>::STRING == nodes_[n].type) || (JSONElement<LENGTH>::NOTSET != type && type != nodes_[n].type)) {
+            if (ERR_NONE == last_error_) {
+                last_error_ = ERR_NOT_FOUND;    // Scalar has no children
+            }
+            return false;
+        }
+        if (nodes_[n].expanded) {
+            return true;
+        }
+        is_map = (JSONElement<LENGTH>::MAP == nodes_[n].type);
+        l = nodes_[n].value.offset + nodes_[n].value.length;
+        i = SkipWhiteSpace(s, nodes_[n].value.offset + 1, l);
+        while(ERR_NONE == last_error_ && i<l && (is_map ? '}' : ']') != s[i]) {
+            uint16_t ki = NONE, vi;
+
+            if (is_map) {
+                if ('\"' != s[i]) {
+                    last_error_ = ERR_BAD_ATTRIBUTE;
+                    break;
+                }
+                ki = i;
+                i = SkipWhiteSpace(s, SkipString(s, i, l), l);
+                if (ERR_NONE != last_error_ || i>=l || ':' != s[i]) {
+                    last_error_ = ERR_BAD_ATTRIBUTE;
+                    break;
+                }
+                i = SkipWhiteSpace(s, i + 1, l);
+            }
+            vi = i;
+            i = SkipValue(s, i, l);
+            if (NONE == Index(s, vi, i, ki)) {
+                break;
+            }
+            i = SkipWhiteSpace(s, i, l);
+            if (i<l && ',' == s[i]) {
+                i = SkipWhiteSpace(s, i + 1, l);
+            }else if (i>=l || (is_map ? '}' : ']') != s[i]) {
+                last_error_ = is_map ? ERR_UNEXPECTED_END_OF_MAP : ERR_UNEXPECTED_END_OF_ARRAY;
+            }
+        }
+        if (ERR_NONE != last_error_) {
+            count_ = first;    // Discard part indexed
+            return false;
+        }
+        nodes_[n].first = first;
+        nodes_[n].count = count_ - first;
+        nodes_[n].expanded = true;
+
+        return true;
+    } // Expand(...)
+
+
+    Entry       nodes_[NODES];              ///< Indexed values
+    uint16_t    count_;                     ///< Number of indexed values
+}; // class JSONLazy
+
+}; // namespace gjson
+
+#endif // GJSON_LAZY_H
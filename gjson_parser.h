@@ -29,6 +29,7 @@ struct JSONConstant {
         ERR_OBJECT_MEMORY_LIMIT,        /// Building, object memory limit reached
         ERR_CHAR_MEMORY_LIMIT,          /// Building, character (I/O) memory limit reached
         ERR_CALLBACK_STOP,              /// Parsing or building, a callback stop condition notified
+        ERR_BAD_ENCODING,               /// Parsing, string is not valid UTF-8
     }ERR;
 
 
@@ -41,10 +42,288 @@ struct JSONConstant {
         OP_FROM_OBJECT,                 /// Operation JSON from object
         OP_FIND_OBJECT,                 /// Operation find JSON from object
         OP_RELEASE_OBJECT,              /// Operation release object
+        OP_ESTIMATE,                    /// Operation estimate object chain size
     }OP;
 }; // struct JSONConstant
 
 
+/**
+ * JSON string span.  Locates JSON text of a key or value within source JSON string without copy; 
+ * quoted strings include their quotes and containers run from opening to matching closing bracket 
+ * so a span may be forwarded as is
+ */
+struct JSONSpan {
+    /**
+     * Constructor, make stable instance with no span
+     */
+    JSONSpan() : offset(0), length(0) { }
+
+
+    /**
+     * Set span from string character indices as given to \ref JSONTokenizer::TokenString
+     *
+     * \param[in] si Start character index of string data
+     * \param[in] l Length of string data, characters
+     * \param[in] quoted Flag indicating string data is enclosed by quotes
+     */
+    void Set(const uint16_t si, const uint16_t l, const bool quoted) {
+        offset = quoted ? si - 1 : si;
+        length = quoted ? l + 2 : l;
+    }
+
+
+    /**
+     * Clear span
+     */
+    void Clear() {
+        offset = length = 0;
+    }
+
+
+    /**
+     * Get span start character index into source JSON string
+     *
+     * \return Index
+     */
+    uint16_t Offset() const {
+        return offset;
+    }
+
+
+    /**
+     * Get span length
+     *
+     * \return Characters, 0 no span
+     */
+    uint16_t Length() const {
+        return length;
+    }
+
+
+    uint16_t    offset;                     ///< Start character index
+    uint16_t    length;                     ///< Length, Characters
+}; // struct JSONSpan
+
+
+/**
+ * JSON string parse state.  Holds everything the non-recursive string parser needs to continue 
+ * a parse stopped by a callback, see \ref JSONParse::FromString
+ */
+struct JSONParseState {
+    /**
+     * Constructor, make stable instance ready to start parsing
+     *
+     * \param[in] psi Parse start character index, default 0
+     */
+    JSONParseState(const uint16_t psi=0) {
+        Reset(psi);
+    }
+
+
+    /**
+     * Reset state, next parse starts afresh
+     *
+     * \param[in] psi Parse start character index, default 0
+     */
+    void Reset(const uint16_t psi=0) {
+        i = psi;
+        ac = mc = 0;
+        str_start = str_end = -1;
+        is_literal = 1;
+        expect_value = false;
+        quoted_processing = false;
+        escape = false;
+        utf8 = 0;
+        active = false;
+    }
+
+
+    /**
+     * Get active state.  A parse stopped by callback is active and may be continued
+     *
+     * \retval true Parse may be continued
+     * \retval false Parse complete or not started
+     */
+    bool IsActive() const {
+        return active;
+    }
+
+
+    /**
+     * Get relative nesting depth, open arrays and maps since parse start
+     *
+     * \return Depth, can be negative when parsing started part way through JSON
+     */
+    int16_t Depth() const {
+        return ac + mc;
+    }
+
+
+    uint16_t    i;                          ///< Next parse character index
+    int16_t     ac;                         ///< Relative array open count
+    int16_t     mc;                         ///< Relative map open count
+    int16_t     str_start;                  ///< Current string start character index, -1 none
+    int16_t     str_end;                    ///< Current string end character index, -1 none
+    uint8_t     is_literal;                 ///< String kind, 0 quoted, 1 undetermined, 2 literal
+    bool        expect_value;               ///< Map value expected flag
+    bool        quoted_processing;          ///< Within quoted string flag
+    bool        escape;                     ///< Escape character pending flag
+    uint8_t     utf8;                       ///< UTF-8 validation state, see \ref JSONSupport::UTF8Next
+    bool        active;                     ///< Parse may be continued flag
+}; // struct JSONParseState
+
+
+/**
+ * JSON parser statistics, see \ref JSONParse::GetStats.  Only gathered when build macro \ref GJSON_STATS is set
+ *
+ * Reset as each new string parse starts, object bytes still allocated carried over, then object chain output, 
+ * find and release add to those of the parse
+ */
+struct JSONParseStats {
+    /**
+     * Enum of token types
+     */
+    typedef enum {
+        TOKEN_ARRAY = 0,                ///< Array open or close
+        TOKEN_MAP,                      ///< Map open or close
+        TOKEN_ATTRIBUTE,                ///< Map attribute/property
+        TOKEN_VALUE,                    ///< Quoted string value
+        TOKEN_LITERAL,                  ///< Literal value
+        TOKEN_COUNT                     ///< Number of token types
+    }TOKEN;
+
+
+    /**
+     * Enum of timed phases
+     */
+    typedef enum {
+        PHASE_PARSE = 0,                ///< \ref JSONParse::FromString
+        PHASE_OUTPUT,                   ///< \ref JSONParse::FromObject
+        PHASE_FIND,                     ///< \ref JSONParse::FindObject
+        PHASE_RELEASE,                  ///< \ref JSONParse::Release
+        PHASE_COUNT                     ///< Number of phases
+    }PHASE;
+
+
+    /**
+     * Constructor, make stable instance with everything zero
+     */
+    JSONParseStats() {
+        Reset();
+    }
+
+
+    /**
+     * Reset, everything zero
+     */
+    void Reset() {
+        uint8_t k;
+
+        bytes = 0;
+        for(k=0; k<TOKEN_COUNT; k++) {
+            tokens[k] = 0;
+        }
+        allocations = frees = 0;
+        object_bytes = peak_object_bytes = 0;
+        max_depth = 0;
+        callbacks = 0;
+        for(k=0; k<PHASE_COUNT; k++) {
+            time[k] = 0;
+        }
+    }
+
+
+    /**
+     * Get tokens of all types
+     *
+     * \return Tokens
+     */
+    uint32_t Tokens() const {
+        uint32_t n = 0;
+
+        for(uint8_t k=0; k<TOKEN_COUNT; k++) {
+            n += tokens[k];
+        }
+
+        return n;
+    }
+
+
+    uint32_t    bytes;                      ///< Characters scanned by string parse
+    uint32_t    tokens[TOKEN_COUNT];        ///< Tokens parsed by type, \ref TOKEN
+    uint32_t    allocations;                ///< Elements allocated
+    uint32_t    frees;                      ///< Elements released
+    uint32_t    object_bytes;               ///< Element bytes allocated and not yet released
+    uint32_t    peak_object_bytes;          ///< Peak of \ref object_bytes, sizes \ref JSONParse::MemoryLimit
+    uint16_t    max_depth;                  ///< Maximum relative nesting depth of arrays and maps
+    uint32_t    callbacks;                  ///< Callback invocations
+    uint32_t    time[PHASE_COUNT];          ///< Time in each phase, \ref PHASE, units of \ref GJSON_STATS_CLOCK
+}; // struct JSONParseStats
+
+
+/**
+ * JSON string search cursor.  Keeps parse state between matches so all occurrences of a search 
+ * string are found in one pass of JSON string, see \ref JSONSimpleStringParse::FromStringSearchNext 
+ * and \ref JSONSimpleStringParseAttr::FromStringSearchNext
+ */
+struct JSONSearchCursor {
+    /**
+     * Constructor, make stable instance ready to start searching
+     *
+     * \param[in] psi Parse start character index, default 0
+     */
+    JSONSearchCursor(const uint16_t psi=0) : si(-1), ei(-1), depth(0), state(psi) { }
+
+
+    /**
+     * Reset cursor, next search starts afresh
+     *
+     * \param[in] psi Parse start character index, default 0
+     */
+    void Reset(const uint16_t psi=0) {
+        si = ei = -1;
+        depth = 0;
+        state.Reset(psi);
+    }
+
+
+    /**
+     * Get match start character index into JSON string, quotes excluded
+     *
+     * \return Index, -1 no match
+     */
+    int16_t Start() const {
+        return si;
+    }
+
+
+    /**
+     * Get match end character index into JSON string, one past last character
+     *
+     * \return Index, -1 no match
+     */
+    int16_t End() const {
+        return ei;
+    }
+
+
+    /**
+     * Get match relative nesting depth, open arrays and maps since search start
+     *
+     * \return Depth
+     */
+    int16_t Depth() const {
+        return depth;
+    }
+
+
+    int16_t     si;                         ///< Match start character index, -1 none
+    int16_t     ei;                         ///< Match end character index, -1 none
+    int16_t     depth;                      ///< Match relative nesting depth
+    JSONParseState state;                   ///< Parse state between matches
+}; // struct JSONSearchCursor
+
+
 /**
  * JSON base parser tokenizer handler abstract class.  Implement methods for callbacks on parsed items both string or object
  *
@@ -142,16 +421,57 @@ public:
 }; // class JSONTokenizer
 
 
+/**
+ * JSON parser callback policy.  Given a handler type (the parser subclass) callbacks are bound at compile time,
+ * no virtual methods exist and unused callbacks compile away
+ *
+ * \tparam LENGTH Maximum length (including NULL terminator) in characters of a string attribute/property
+ * \tparam P Parser type
+ * \tparam H Handler type
+ */
+template<uint8_t LENGTH, class P, class H>
+class JSONTokenPolicy {
+protected:
+    typedef H   TokenHandler;               ///< Type implementing callbacks
+}; // class JSONTokenPolicy
+
+
+/**
+ * JSON parser callback policy without handler type.  Callbacks are virtual, see \ref JSONTokenizer
+ *
+ * \tparam LENGTH Maximum length (including NULL terminator) in characters of a string attribute/property
+ * \tparam P Parser type
+ */
+template<uint8_t LENGTH, class P>
+class JSONTokenPolicy<LENGTH, P, void> : public JSONTokenizer<LENGTH> {
+protected:
+    typedef P   TokenHandler;               ///< Type implementing callbacks
+}; // class JSONTokenPolicy
+
+
 /**
  * JSON base non-recursive parser offering string parsing using user supplied I/O.  Features include parsing string with tokenised callbacks for basic JSON elements,
  * object chain creation, searching objects, moving around object chain and converting objects back into JSON.
  *
  * Implementation is pretty skinny to keep footprint down to meet where possible, memory requirements of a resource limited micro controller.
  *
+ * Callbacks are virtual by default.  A subclass giving itself as handler type H has its callbacks bound at compile time
+ * instead (curiously recurring template), befriend the base parser so it may call them:
+ *
+ *   class MyParse : protected JSONParse<LENGTH, MyParse> {
+ *       friend class JSONParse<LENGTH, MyParse>;
+ *       bool TokenString(const JSONString<LENGTH>* e, char *s=NULL, int16_t si=0, int16_t ei=0) { ... }
+ *   };
+ *
+ * I/O is virtual \ref IO by default.  Giving a concrete I/O type I, such as \ref UserSpan, makes all I/O access direct
+ * so it may inline.
+ *
  * \tparam LENGTH Maximum length (including NULL terminator) in characters of a string attribute/property
+ * \tparam H Handler type, subclass implementing callbacks or void (default) for virtual callbacks
+ * \tparam I I/O type, default \ref IO
  */
-template<uint8_t LENGTH>
-class JSONParse : public JSONConstant, public JSONTokenizer<LENGTH> {
+template<uint8_t LENGTH, class H=void, class I=IO>
+class JSONParse : public JSONConstant, public JSONTokenPolicy<LENGTH, JSONParse<LENGTH, H, I>, H> {
 public:
     /**
      * Constructor, make stable instance with I/O and object memory limit specifiers
@@ -159,22 +479,33 @@ public:
      * \param[in,out] io Pointer to I/O instance
      * \param[in] memory_limit Size (Bytes) of object memory if any.  Defaults to 256 Bytes
      */
-    JSONParse(IO* io, uint16_t memory_limit=256) : binary_size_(0), io_(io), last_error_(ERR_NONE), \
-                                operation_(OP_NONE), like_(NULL), limit_node_level_(true), callbacks_(false), \
-                                case_sensitive_(true), last_e_(NULL), limit_memory_(memory_limit) { }
+    JSONParse(I* io, uint32_t memory_limit=256) : last_error_(ERR_NONE), operation_(OP_NONE), binary_size_(0), \
+                                limit_memory_(memory_limit), io_(io), limit_node_level_(true), callbacks_(false), \
+                                case_sensitive_(true), validate_utf8_(false), last_e_(NULL), like_(NULL), state_(NULL), \
+                                intern_(NULL), key_(NULL), pool_(NULL), pack_numbers_(false), pack_float_(false) { }
+
+
+    /**
+     * Destructor, release found interned attribute/property copy if any, see \ref FindString
+     */
+    ~JSONParse() {
+        if (key_) {
+            GJSON_RELEASE_OBJECT( key_ );
+        }
+    }
 
 
-    virtual bool TokenArray(const JSONArray<LENGTH>* e, char *s=NULL, uint16_t i=0) {
+    bool TokenArray(const JSONArray<LENGTH>* e, char *s=NULL, uint16_t i=0) {
         return false;
     }
 
 
-    virtual bool TokenMap(const JSONArray<LENGTH>* e, char *s=NULL, uint16_t i=0) {
+    bool TokenMap(const JSONArray<LENGTH>* e, char *s=NULL, uint16_t i=0) {
         return false;
     }
 
 
-    virtual bool TokenString(const JSONString<LENGTH>* e, char *s=NULL, int16_t si=0, int16_t ei=0) {
+    bool TokenString(const JSONString<LENGTH>* e, char *s=NULL, int16_t si=0, int16_t ei=0) {
         return false;
     }
 
@@ -196,7 +527,8 @@ public:
      * \note If JSON object chain to large, consider increasing via \ref MemoryLimit
      *
      * \note After use, caller can assess what would be the object chain memory footprint via
-     * \ref GetBinarySize.  This is calculated even if no objects are generated
+     * \ref GetBinarySize.  This is calculated even if no objects are generated, to size a chain 
+     * before parsing see \ref Estimate
      *
      * \todo Refactor object chain elements to release themself
      *
@@ -232,7 +564,11 @@ public:
      * \note If JSON object chain to large, consider increasing via \ref MemoryLimit
      *
      * \note After use, caller can assess what would be the object chain memory footprint via
-     * \ref GetBinarySize.  This is calculated even if no objects are generated
+     * \ref GetBinarySize.  This is calculated even if no objects are generated, to size a chain 
+     * before parsing see \ref Estimate
+     *
+     * \note Without object chain no elements are allocated, callbacks are given elements valid 
+     * until the next element of same type
      *
      * \todo Refactor object chain elements to release themself
      *
@@ -243,65 +579,180 @@ public:
      * \return Last character index parsed.  Debug aid upon error conditions
      */
     uint16_t FromString(char *s, JSONElement<LENGTH>** h=NULL, uint16_t psi=0) {
-        uint8_t    is_literal = 1; // Could be quoted or literal
+        JSONParseState ps(psi);
+
+        return FromString(s, h, psi, &ps);
+    }
+
+
+    /**
+     * Parse given JSON string with caller owned parse state, optionally build JSON object chain.
+     * A parse stopped by a callback (\ref ERR_CALLBACK_STOP) leaves the state active so invoking 
+     * again with the same state continues from the character following the stop, array and map 
+     * nesting intact.  Node level checks of \ref LimitNodeLevel remain valid across continues.
+     *
+     * \attention Caller should check \ref GetLastError upon completion for any error
+     * condition that may have risen during parse
+     *
+     * \attention An object chain is not continued, only use h with a new parse state
+     *
+     * \param[in] s JSON source string, NULL terminated
+     * \param[in] h Pointer to pointer of JSON element to take object chain updates or NULL
+     * \param[in] psi Parse start character index, ignored when continuing
+     * \param[in,out] ps Pointer to parse state.  When not active a new parse is started from psi
+     * \return Last character index parsed.  Debug aid upon error conditions
+     */
+    uint16_t FromString(char *s, JSONElement<LENGTH>** h, uint16_t psi, JSONParseState* ps) {
+        if (!h) {
+            return FromStringScratch(s, psi, ps);
+        }
+
+        return FromString(s, h, psi, ps, NULL);
+    }
+
+protected:
+    /**
+     * Elements given to callbacks when parsing without object chain.  Two of each type alternate so 
+     * current and last remain valid
+     */
+    typedef struct {
+        JSONArray<LENGTH> a[2];             ///< Arrays
+        JSONMap<LENGTH> m[2];               ///< Maps
+        JSONString<LENGTH> s[2];            ///< Strings
+        uint8_t     ak;                     ///< Array slot index of last taken
+        uint8_t     mk;                     ///< Map slot index of last taken
+        uint8_t     sk;                     ///< String slot index of last taken
+    }ScratchElements;
+
+
+    /**
+     * Parse given JSON string without object chain, see \ref FromString.  Scratch elements are held on 
+     * the stack of this call only, not inlined so parsing with an object chain doesn't reserve them
+     *
+     * \param[in] s JSON source string, NULL terminated
+     * \param[in] psi Parse start character index, ignored when continuing
+     * \param[in,out] ps Pointer to parse state
+     * \return Last character index parsed
+     */
+    GJSON_NOINLINE uint16_t FromStringScratch(char *s, uint16_t psi, JSONParseState* ps) {
+        ScratchElements sc;
+
+        sc.ak = sc.mk = sc.sk = 0;
+
+        return FromString(s, NULL, psi, ps, &sc);
+    }
+
+
+    /**
+     * Parse given JSON string with caller owned parse state, see \ref FromString
+     *
+     * \param[in] s JSON source string, NULL terminated
+     * \param[in] h Pointer to pointer of JSON element to take object chain updates or NULL
+     * \param[in] psi Parse start character index, ignored when continuing
+     * \param[in,out] ps Pointer to parse state.  When not active a new parse is started from psi
+     * \param[in,out] sc Pointer to scratch elements, required when h is NULL
+     * \return Last character index parsed.  Debug aid upon error conditions
+     */
+    uint16_t FromString(char *s, JSONElement<LENGTH>** h, uint16_t psi, JSONParseState* ps, ScratchElements* sc) {
+        JSONParseState& st = *ps;
         uint16_t l = strlen(s), i;
-        int16_t ac = 0, mc = 0;
-        int16_t str_start = -1, str_end = -1;
         JSONElement<LENGTH>* e = NULL;
-        bool expect_value = false;
         bool stop = false;
-        bool quoted_processing = false;
-        bool escape = false;
-
+        uint16_t n = 0;
+        uint32_t t = StatsClock();
+
+        GJSON_TRACE_BEGIN("FromString", l);
+        if (!st.IsActive()) {
+            st.Reset(psi);
+            binary_size_ = 0;
+            StatsReset();
+        }else if (limit_node_level_ && 0==st.ac && 0==st.mc) {
+            l = st.i;    // Base of where parsing started already reached, nothing to continue
+        }
+        st.active = false;
+        state_ = ps;
         last_e_ = NULL;
         like_ = NULL;
         last_error_ = ERR_NONE;
         operation_ = OP_FROM_STRING;
-        binary_size_ = 0;
-        for(i=psi; i<l; i++) {
-            if (quoted_processing) { // Quoted string
-                if (!escape) {
-                    if ('\\' == s[i] && !escape) {
-                        escape = true;
+        psi = st.i;    // Characters scanned counted from here
+        for(i=st.i; i<l; i++) {
+            if (st.quoted_processing && !st.escape && !st.utf8) {
+                // Plain string content needs no processing, skip in bulk
+                i += JSONSupport::StringRun(&s[i], l - i);
+                if (i>=l) {
+                    st.i = l;
+                    break;
+                }
+            }
+            st.i = i + 1;    // Continue point should a callback stop
+            if (st.quoted_processing) { // Quoted string
+                if (!st.escape) {
+                    if (validate_utf8_ && (st.utf8 || static_cast<uint8_t>(s[i]) >= 0x80)) {
+                        if (!JSONSupport::UTF8Next(st.utf8, s[i])) {
+                            last_error_ = ERR_BAD_ENCODING;
+                        }
+                    }else if ('\\' == s[i] && !st.escape) {
+                        st.escape = true;
                     }else if ('\"' == s[i]) {
                         // Data enclose
-                        if ((-1 == str_start) || (-1 != str_end)) {
-                            if (expect_value) {
+                        if ((-1 == st.str_start) || (-1 != st.str_end)) {
+                            if (st.expect_value) {
                                 last_error_ = ERR_BAD_VALUE;
                             }else {
                                 last_error_ = ERR_BAD_ATTRIBUTE;
                             }
-                        }else if (-1 == str_end) {
+                        }else if (-1 == st.str_end) {
                             // String between str_start and i
-                            str_end = i;
-                            quoted_processing = false;
+                            st.str_end = i;
+                            st.quoted_processing = false;
                         }
                     }
                 }else {
-                    escape = false;
+                    st.escape = false;
                 }
             }
             
-            if (ERR_NONE == last_error_ && !quoted_processing) {
+            if (ERR_NONE == last_error_ && !st.quoted_processing) {
                 char cc = s[i];
 
                 // Assume undetermined
                 switch(cc) {
                     case '[' : {    // Array open
-                        if (!h || limit_memory_ >= (binary_size_ + sizeof(JSONArray<LENGTH>))) {
-                            auto a = GJSON_NEW_OBJECT( JSONArray<LENGTH>(e), JSONArray<LENGTH> );
+                        if (h && pack_numbers_ && !callbacks_) {
+                            // Array of only numeric literals is one element
+                            uint16_t ni = i;
+                            auto a = Numbers(s, i, l, e);
 
-                            // No objects wanted, release
-                            if (!h && last_e_) {
-                                GJSON_RELEASE_OBJECT( last_e_ );
+                            if (a) {
+                                a->Source(ni, i + 1 - ni);
+                                last_e_ = e;
+                                e = a;
+                                st.i = i + 1;
+                                st.is_literal = 1;
+                                st.expect_value = false;
+                                binary_size_ += ElementSize(a);
+                                StatsToken(a, h, st.Depth() + 1, n);
+                                break;
+                            }else if (ERR_NONE != last_error_) {
+                                break;
                             }
+                        }
+                        if (!h || limit_memory_ >= (binary_size_ + sizeof(JSONArray<LENGTH>))) {
+                            auto a = (h ? NewArray(true, e) : Scratch(sc->a, sc->ak, JSONArray<LENGTH>(true)));
+                            if (!a) {
+                                break;    // Out of memory
+                            }
+
+                            a->Source(i, 1);
                             last_e_ = e;
                             e = a;
                             if (callbacks_) {
-                                stop = TokenArray(a, s, i);
+                                stop = Tokens()->TokenArray(a, s, i);
                             }
-                            ac++;
+                            st.ac++;
                             binary_size_ += sizeof(JSONArray<LENGTH>);
+                            StatsToken(a, h, st.Depth(), n);
                         }else {
                             last_error_ = ERR_OBJECT_MEMORY_LIMIT;
                         }
@@ -309,48 +760,50 @@ public:
                     break;
 
                     case ']' : {    // Array close
-                        uint16_t bsz = binary_size_ + ((-1 < str_start) ? sizeof(JSONString<LENGTH>) + sizeof(JSONArray<LENGTH>) : sizeof(JSONArray<LENGTH>));
+                        uint32_t bsz = binary_size_ + ((-1 < st.str_start) ? sizeof(JSONString<LENGTH>) + sizeof(JSONArray<LENGTH>) : sizeof(JSONArray<LENGTH>));
 
                         if (!h || limit_memory_ >= bsz) {
-                            if (-1 < str_start) {
+                            if (-1 < st.str_start) {
                                 // Quoted string value.  We arn't using constructor because we want to know of there was an error setting data and we arn't using Exceptions
-                                auto a = GJSON_NEW_OBJECT( JSONString<LENGTH>(true, e), JSONString<LENGTH> );
+                                auto a = (h ? NewString(true, e) : Scratch(sc->s, sc->sk, JSONString<LENGTH>(true)));
+                                if (!a) {
+                                    break;    // Out of memory
+                                }
 
-                                if (!a->Data(&s[str_start], ((2 == is_literal)?true:false), static_cast<uint8_t>(str_end - str_start))) {
+                                if (!ValueData(a, &s[st.str_start], st.str_end - st.str_start, (2 == st.is_literal))) {
                                     last_error_ = ERR_BAD_VALUE;
                                 }else {
-                                    is_literal = 1; // Undetermined as yet
-                                    expect_value = false;
+                                    Source(a, st);
+                                    st.is_literal = 1; // Undetermined as yet
+                                    st.expect_value = false;
                                 }
 
-                                // No objects wanted, release
-                                if (!h && last_e_) {
-                                    GJSON_RELEASE_OBJECT( last_e_ );
-                                }
                                 last_e_ = e;
                                 e = a;
                                 if (callbacks_) {
-                                    stop = TokenString(a, s, str_start, str_end);
+                                    stop = Tokens()->TokenString(a, s, st.str_start, st.str_end);
                                     if (stop) {
-                                        i = str_start-1;    // -1 to include opening quote
+                                        i = st.str_start-1;    // -1 to include opening quote
                                     }
                                 }
-                                str_start = str_end = -1;
+                                st.str_start = st.str_end = -1;
                                 binary_size_ += sizeof(JSONString<LENGTH>);
+                                StatsToken(a, h, st.Depth(), n);
                             }
-                            auto a = GJSON_NEW_OBJECT( JSONArray<LENGTH>(e, false), JSONArray<LENGTH> );
-
-                            // No objects wanted, release
-                            if (!h && last_e_) {
-                                GJSON_RELEASE_OBJECT( last_e_ );
+                            auto a = (h ? NewArray(false, e) : Scratch(sc->a, sc->ak, JSONArray<LENGTH>(false)));
+                            if (!a) {
+                                break;    // Out of memory
                             }
+
+                            a->Source(i, 1);
                             last_e_ = e;
                             e = a;
                             if (!stop && callbacks_) {
-                                stop = TokenArray(a, s, i);
+                                stop = Tokens()->TokenArray(a, s, i);
                             }
-                            ac--;
+                            st.ac--;
                             binary_size_ += sizeof(JSONArray<LENGTH>);
+                            StatsToken(a, h, st.Depth(), n);
                         }else {
                             last_error_ = ERR_OBJECT_MEMORY_LIMIT;
                         }
@@ -359,19 +812,20 @@ public:
 
                     case '{' : {    // Map open
                         if (!h || limit_memory_ >= (binary_size_ + sizeof(JSONMap<LENGTH>))) {
-                            auto a = GJSON_NEW_OBJECT( JSONMap<LENGTH>(e), JSONMap<LENGTH> );
-
-                            // No objects wanted, release
-                            if (!h && last_e_) {
-                                GJSON_RELEASE_OBJECT( last_e_ );
+                            auto a = (h ? NewMap(true, e) : Scratch(sc->m, sc->mk, JSONMap<LENGTH>(true)));
+                            if (!a) {
+                                break;    // Out of memory
                             }
+
+                            a->Source(i, 1);
                             last_e_ = e;
                             e = a;
                             if (callbacks_) {
-                                stop = TokenMap(a, s, i);
+                                stop = Tokens()->TokenMap(a, s, i);
                             }
-                            mc++;
+                            st.mc++;
                             binary_size_ += sizeof(JSONMap<LENGTH>);
+                            StatsToken(a, h, st.Depth(), n);
                         }else {
                             last_error_ = ERR_OBJECT_MEMORY_LIMIT;
                         }
@@ -379,48 +833,50 @@ public:
                     break;
 
                     case '}' : {    // Map close
-                        uint16_t bsz = binary_size_ + ((-1 < str_start) ? sizeof(JSONString<LENGTH>) + sizeof(JSONMap<LENGTH>) : sizeof(JSONMap<LENGTH>));
+                        uint32_t bsz = binary_size_ + ((-1 < st.str_start) ? sizeof(JSONString<LENGTH>) + sizeof(JSONMap<LENGTH>) : sizeof(JSONMap<LENGTH>));
 
                         if (!h || limit_memory_ >= bsz) {
-                            if (-1 < str_start) {
+                            if (-1 < st.str_start) {
                                 // Quoted string value.  We arn't using constructor because we want to know of there was an error setting data and we arn't using Exceptions
-                                auto a = GJSON_NEW_OBJECT( JSONString<LENGTH>(true, e), JSONString<LENGTH> );
+                                auto a = (h ? NewString(true, e) : Scratch(sc->s, sc->sk, JSONString<LENGTH>(true)));
+                                if (!a) {
+                                    break;    // Out of memory
+                                }
 
-                                if (!a->Data(&s[str_start], ((2 == is_literal)?true:false), static_cast<uint8_t>(str_end - str_start))) {
+                                if (!ValueData(a, &s[st.str_start], st.str_end - st.str_start, (2 == st.is_literal))) {
                                     last_error_ = ERR_BAD_VALUE;
                                 }else {
-                                    is_literal = 1; // Undetermined as yet
-                                    expect_value = false;
+                                    Source(a, st);
+                                    st.is_literal = 1; // Undetermined as yet
+                                    st.expect_value = false;
                                 }
 
-                                // No objects wanted, release
-                                if (!h && last_e_) {
-                                    GJSON_RELEASE_OBJECT( last_e_ );
-                                }
                                 last_e_ = e;
                                 e = a;
                                 if (callbacks_) {
-                                    stop = TokenString(a, s, str_start, str_end);
+                                    stop = Tokens()->TokenString(a, s, st.str_start, st.str_end);
                                     if (stop) {
-                                        i = str_start-1;    // -1 to include opening quote
+                                        i = st.str_start-1;    // -1 to include opening quote
                                     }
                                 }
-                                str_start = str_end = -1;
+                                st.str_start = st.str_end = -1;
                                 binary_size_ += sizeof(JSONString<LENGTH>);
+                                StatsToken(a, h, st.Depth(), n);
                             }
-                            auto a = GJSON_NEW_OBJECT( JSONMap<LENGTH>(e, false), JSONMap<LENGTH> );
-
-                            // No objects wanted, release
-                            if (!h && last_e_) {
-                                GJSON_RELEASE_OBJECT( last_e_ );
+                            auto a = (h ? NewMap(false, e) : Scratch(sc->m, sc->mk, JSONMap<LENGTH>(false)));
+                            if (!a) {
+                                break;    // Out of memory
                             }
+
+                            a->Source(i, 1);
                             last_e_ = e;
                             e = a;
                             if (!stop && callbacks_) {
-                                stop = TokenMap(a, s, i);
+                                stop = Tokens()->TokenMap(a, s, i);
                             }
-                            mc--;
+                            st.mc--;
                             binary_size_ += sizeof(JSONMap<LENGTH>);
+                            StatsToken(a, h, st.Depth(), n);
                         }else {
                             last_error_ = ERR_OBJECT_MEMORY_LIMIT;
                         }
@@ -429,8 +885,8 @@ public:
 
                     case '\"' :    // Data enclose
                         // Were we already sampling a literal?
-                        if (is_literal == 2) {
-                            if (expect_value) {
+                        if (st.is_literal == 2) {
+                            if (st.expect_value) {
                                 last_error_ = ERR_BAD_VALUE;
                                 break;
                             }else {
@@ -438,37 +894,70 @@ public:
                                 break;
                             }
                         }
-                        if (-1 == str_start) {
-                            str_start = i + 1;
-                            is_literal = 0;        // Quoted string
-                            quoted_processing = true;
+                        if (-1 == st.str_start) {
+                            st.str_start = i + 1;
+                            st.is_literal = 0;        // Quoted string
+                            st.quoted_processing = true;
                         }
                     break;
 
                     case ':' : {    // Attribute/Property
                         if (!h || limit_memory_ >= (binary_size_ + sizeof(JSONString<LENGTH>))) {
-                            if (is_literal || (-1 == str_start) || (-1 == str_end)) {
+                            if (st.is_literal || (-1 == st.str_start) || (-1 == st.str_end)) {
                                 last_error_ = ERR_BAD_ATTRIBUTE;
                             }else {
                                 // Attribute/Property is always quoted
-                                auto a = GJSON_NEW_OBJECT( JSONString<LENGTH>(&s[str_start], static_cast<uint8_t>(str_end - str_start), e, false), JSONString<LENGTH>);
+                                JSONString<LENGTH>* a;
+                                JSONElement<LENGTH>* k;
+
+                                if (h && intern_) {
+                                    // Decoded into parser held string for callbacks, object chain holds table identifier
+                                    uint16_t id;
 
-                                // No objects wanted, release
-                                if (!h && last_e_) {
-                                    GJSON_RELEASE_OBJECT( last_e_ );
+                                    if (!key_) {
+                                        key_ = GJSON_NEW_OBJECT( JSONString<LENGTH>(false), JSONString<LENGTH> );
+                                    }
+                                    a = key_;
+                                    if (!a) {
+                                        last_error_ = ERR_OBJECT_MEMORY_LIMIT;
+                                        break;
+                                    }
+                                    a->Unlink();
+                                    a->DataEscaped(&s[st.str_start], st.str_end - st.str_start);
+                                    id = intern_->Intern(a->Data(), a->Length());
+                                    if (JSONIntern<LENGTH>::NONE != id) {
+                                        k = GJSON_NEW_OBJECT( JSONKey<LENGTH>(id), JSONKey<LENGTH> );
+                                    }else {
+                                        // Table full, plain string
+                                        k = GJSON_NEW_OBJECT( JSONString<LENGTH>(*a), JSONString<LENGTH> );
+                                    }
+                                    k = Linked(k, e);
+                                    if (!k) {
+                                        break;    // Out of memory
+                                    }
+                                }else {
+                                    a = (h ? NewString(false, e) : Scratch(sc->s, sc->sk, JSONString<LENGTH>(false)));
+                                    if (!a) {
+                                        break;    // Out of memory
+                                    }
+                                    a->DataEscaped(&s[st.str_start], st.str_end - st.str_start);
+                                    k = a;
                                 }
+
+                                Source(k, st);
                                 last_e_ = e;
-                                e = a;
+                                e = k;
                                 if (callbacks_) {
-                                    stop = TokenString(a, s, str_start, str_end);
+                                    stop = Tokens()->TokenString(a, s, st.str_start, st.str_end);
                                     if (stop) {
-                                        i = str_start-1;
+                                        i = st.str_start-1;
                                     }
                                 }
-                                expect_value = true;
-                                is_literal = 1;    // Could be literal OR quoted string, not sure yet
-                                str_start = str_end = -1;
-                                binary_size_ += sizeof(JSONString<LENGTH>);
+                                st.expect_value = true;
+                                st.is_literal = 1;    // Could be literal OR quoted string, not sure yet
+                                st.str_start = st.str_end = -1;
+                                binary_size_ += ElementSize(k);
+                                StatsToken(k, h, st.Depth(), n);
                             }
                         }else {
                             last_error_ = ERR_OBJECT_MEMORY_LIMIT;
@@ -478,40 +967,41 @@ public:
 
                     case ',' : {    // Value
                         // Situation where a map or array ends the last string would have be dealt with and this comma is after the container so no data
-                        if (-1 < str_start) {
+                        if (-1 < st.str_start) {
                             if (!h || limit_memory_ >= (binary_size_ + sizeof(JSONString<LENGTH>))) {
-                                if (is_literal==1 || (-1 == str_start) || (-1 == str_end)) {
+                                if (st.is_literal==1 || (-1 == st.str_start) || (-1 == st.str_end)) {
                                     last_error_ = ERR_BAD_VALUE;
                                 }else {
                                     // Kind of bug in the way literals are checked in main character switch(...), in quoted string handling end is current i which is ending quote
                                     // but for literals without quotes the end is actually the end character so we have to move it on 1.
 
                                     // String value (maybe quoted).  We arn't using constructor because we want to know of there was an error setting data and we arn't using Exceptions
-                                    auto a = GJSON_NEW_OBJECT( JSONString<LENGTH>(true, e), JSONString<LENGTH> );
+                                    auto a = (h ? NewString(true, e) : Scratch(sc->s, sc->sk, JSONString<LENGTH>(true)));
+                                    if (!a) {
+                                        break;    // Out of memory
+                                    }
 
-                                    if (!a->Data(&s[str_start], ((2 == is_literal)?true:false), static_cast<uint8_t>(str_end - str_start))) {
+                                    if (!ValueData(a, &s[st.str_start], st.str_end - st.str_start, (2 == st.is_literal))) {
                                         last_error_ = ERR_BAD_VALUE;
                                     }
 
-                                    is_literal = 1; // Undetermined
+                                    Source(a, st);
+                                    st.is_literal = 1; // Undetermined
 
-                                    // No objects wanted, release
-                                    if (!h && last_e_) {
-                                        GJSON_RELEASE_OBJECT( last_e_ );
-                                    }
                                     last_e_ = e;
                                     e = a;
                                     if (callbacks_) {
-                                        stop = TokenString(a, s, str_start, str_end);
+                                        stop = Tokens()->TokenString(a, s, st.str_start, st.str_end);
                                         if (stop) {
-                                            i = str_start;
+                                            i = st.str_start;
                                         }
                                         if (!a->IsValueLiteral()) {
                                             i--; // Include opening quote
                                         }
                                     }
-                                    str_start = str_end = -1;
+                                    st.str_start = st.str_end = -1;
                                     binary_size_ += sizeof(JSONString<LENGTH>);
+                                    StatsToken(a, h, st.Depth(), n);
                                 }
                             }else {
                                 last_error_ = ERR_OBJECT_MEMORY_LIMIT;
@@ -520,18 +1010,18 @@ public:
                     }
                     break;
                     default:
-		                if (mc==0 && ac==0) {
+		                if (limit_node_level_ && st.mc==0 && st.ac==0) {
 							last_error_ = ERR_UNEXPECTED_DATA;
 						}else {
-							if ((1 <= is_literal) /*&& expect_value*/) {
-								if (-1 == str_start) {
+							if ((1 <= st.is_literal) /*&& expect_value*/) {
+								if (-1 == st.str_start) {
 									if (s[i] == '\t' || s[i] == ' ') {
 										break;    // Ignore white space
 									}else {
 										if (IsLiteralCharater(s[i])) {
-											is_literal = 2;    // We are sampling a literal, ignore quoted string processing
-											str_start = i;
-											str_end = i + 1;    // Literals cannot be 0 length
+											st.is_literal = 2;    // We are sampling a literal, ignore quoted string processing
+											st.str_start = i;
+											st.str_end = i + 1;    // Literals cannot be 0 length
 										}else {
 											last_error_ = ERR_BAD_VALUE;
 										}
@@ -542,7 +1032,7 @@ public:
 									}else {
 										// Literal continues
 										if (IsLiteralCharater(s[i])) {
-											str_end = i + 1;    // Literals cannot be 0 length
+											st.str_end = i + 1;    // Literals cannot be 0 length
 										}else {
 											last_error_ = ERR_BAD_VALUE;
 										}
@@ -551,7 +1041,7 @@ public:
 							}
 						}
                 } // switch(s[i])
-            } // if (ERR_NONE == last_error_ && !quoted_processing)
+            } // if (ERR_NONE == last_error_ && !st.quoted_processing)
 
             if (h && e && !*h) {
                 *h = e;
@@ -563,14 +1053,14 @@ public:
             }
             if (limit_node_level_) {
                 // Relative open/close sanity check
-                if (ac<0) {
+                if (st.ac<0) {
                     last_error_ = ERR_UNEXPECTED_END_OF_ARRAY;
                 }
-                if (mc<0) {
+                if (st.mc<0) {
                     last_error_ = ERR_UNEXPECTED_END_OF_MAP;
                 }
                 // Have we reached the base of where we started parsing?
-                if (mc==0 && ac==0) {
+                if (st.mc==0 && st.ac==0) {
                     break;
                 }
             }
@@ -578,45 +1068,146 @@ public:
                 break;
             }
         } // for(i=0; ...)
-        if (!h) {
-            // No objects wanted, release
-            if (last_e_) {
-                GJSON_RELEASE_OBJECT( last_e_ );
-            }
-            if (e) {
-                GJSON_RELEASE_OBJECT( e );
-            }
-        }
-        if (!last_error_ && (-1 != str_start) && (-1 == str_end)) {
+        if (!last_error_ && (-1 != st.str_start) && (-1 == st.str_end)) {
             last_error_ = ERR_UNTERMINATED_STRING;
         }
         if (!last_error_ && limit_node_level_) {
             // Final relative open/close sanity check
-            if (0!=ac) {
+            if (0!=st.ac) {
                 last_error_ = ERR_UNEXPECTED_END_OF_ARRAY;
             }
-            if (0!=mc) {
+            if (0!=st.mc) {
                 last_error_ = ERR_UNEXPECTED_END_OF_MAP;
             }
         }
 
+        st.active = (ERR_CALLBACK_STOP == last_error_);
+        state_ = NULL;
         last_e_ = NULL;
+        StatsPhase(JSONParseStats::PHASE_PARSE, t, st.i - psi);
+        GJSON_TRACE_END("FromString", l, n);
 
         return i;
     } // FromString(...)
 
+public:
 
     /**
-     * Parse given JSON object chain, build JSON string in I/O object, optionally build JSON 
-     * string.
+     * Dry run of given JSON string giving exact object chain size \ref FromString would build, without 
+     * creating elements, copying strings or invoking callbacks.  Reserve memory or reject oversized 
+     * input before parsing.  Also sets \ref GetBinarySize
      *
-     * \attention If callbacks employed via \ref Callbacks set to true then NO output string 
-     * is created.  It is assumed the callbacks will handle JSON string generation.
+     * \note Packed numeric arrays are sized as built, see \ref PackNumbers.  With an intern table the size is an 
+     * upper bound, attribute/properties are sized as strings not the \ref JSONKey elements interning may give, 
+     * see \ref Intern
      *
-     * \note If I/O object is not a buffer of some kind you may not have any resulting 
-     * JSON string.
+     * \attention Only string termination and array and map nesting are checked, JSON is validated by 
+     * \ref FromString
      *
-     * \note If object chain not start then node alignments will not be met, i.e.
+     * \note As \ref FromString, with \ref LimitNodeLevel set (default) sizing stops at the end of the 
+     * first array or map
+     *
+     * \param[in] s JSON source string, NULL terminated
+     * \param[out] count Pointer to take element count, default NULL (not wanted)
+     * \param[in] psi Parse start character index, default 0
+     * \return Object chain size, Bytes.  0 on error, check \ref GetLastError
+     */
+    uint32_t Estimate(const char *s, uint32_t* count=NULL, const uint16_t psi=0) {
+        uint16_t l = strlen(s), i;
+        uint32_t ae = 0, me = 0, se = 0, ne = 0, nb = 0;
+        int16_t ac = 0, mc = 0;
+        bool literal = false;
+
+        last_error_ = ERR_NONE;
+        operation_ = OP_ESTIMATE;
+        binary_size_ = 0;
+        for(i=psi; i<l && ERR_NONE == last_error_; i++) {
+            char c = s[i];
+
+            if ('\"' == c) {
+                // Attribute/property or value, skip string content
+                se++;
+                literal = false;
+                for(i++; i<l; i++) {
+                    i += JSONSupport::StringRun(&s[i], l - i);
+                    if (i>=l || '\"' == s[i]) {
+                        break;
+                    }
+                    if ('\\' == s[i]) {
+                        i++;    // Escaped character
+                    }
+                }
+                if (i>=l) {
+                    last_error_ = ERR_UNTERMINATED_STRING;
+                }
+            }else if (IsLiteralCharater(c)) {
+                if (!literal) {
+                    se++;    // Literal value
+                    literal = true;
+                }
+            }else if (' ' != c && '\t' != c && '\r' != c && '\n' != c) {
+                literal = false;
+                switch(c) {
+                    case '[' : {
+                        typename JSONNumbers<LENGTH>::KIND kind;
+                        uint16_t j, n;
+
+                        if (pack_numbers_ && !callbacks_ && NumbersKind(s, i, l, j, n, kind)) {
+                            // Packed as one element, skip to array close
+                            ne++;
+                            nb += sizeof(JSONNumbers<LENGTH>) + static_cast<uint32_t>(n) * JSONNumbers<LENGTH>::Size(kind);
+                            i = j;
+                        }else {
+                            ae++;
+                            ac++;
+                        }
+                    }
+                    break;
+                    case ']' : ae++; ac--; break;
+                    case '{' : me++; mc++; break;
+                    case '}' : me++; mc--; break;
+                    default : break;
+                }
+                if (limit_node_level_) {
+                    if (ac<0) {
+                        last_error_ = ERR_UNEXPECTED_END_OF_ARRAY;
+                    }else if (mc<0) {
+                        last_error_ = ERR_UNEXPECTED_END_OF_MAP;
+                    }else if ((']' == c || '}' == c) && 0==ac && 0==mc) {
+                        break;    // Base of where sizing started reached
+                    }
+                }
+            }
+        }
+        if (ERR_NONE == last_error_ && limit_node_level_) {
+            if (0!=ac) {
+                last_error_ = ERR_UNEXPECTED_END_OF_ARRAY;
+            }else if (0!=mc) {
+                last_error_ = ERR_UNEXPECTED_END_OF_MAP;
+            }
+        }
+        if (ERR_NONE == last_error_) {
+            binary_size_ = ae * sizeof(JSONArray<LENGTH>) + me * sizeof(JSONMap<LENGTH>) + se * sizeof(JSONString<LENGTH>) + nb;
+        }
+        if (count) {
+            *count = (ERR_NONE == last_error_) ? ae + me + se + ne : 0;
+        }
+
+        return binary_size_;
+    } // Estimate(...)
+
+
+    /**
+     * Parse given JSON object chain, build JSON string in I/O object, optionally build JSON 
+     * string.
+     *
+     * \attention If callbacks employed via \ref Callbacks set to true then NO output string 
+     * is created.  It is assumed the callbacks will handle JSON string generation.
+     *
+     * \note If I/O object is not a buffer of some kind you may not have any resulting 
+     * JSON string.
+     *
+     * \note If object chain not start then node alignments will not be met, i.e.
      * there maybe more Array or Map closes than opens.  In this situation caller should 
      * disable via \ref LimitNodeLevel
      *
@@ -628,19 +1219,24 @@ public:
         bool wr_err = false;
         bool stop = false;
         int16_t ac = 0, mc = 0;
+        uint16_t n = 0;
+        JSONString<LENGTH> ks(false);    // Interned attribute/property
+        uint32_t t = StatsClock();
 
+        GJSON_TRACE_BEGIN("FromObject", 0);
         last_e_ = NULL;
         like_ = NULL;
         last_error_ = ERR_NONE;
         operation_ = OP_FROM_OBJECT;
         io_->Length(0);
         while(e) {
+            n++;
             switch(e->Type()) {
                 case JSONElement<LENGTH>::ARRAY : {
                     auto s = reinterpret_cast<JSONArray<LENGTH>*>(e);
 
                     if (callbacks_) {
-                        stop = TokenArray(s);
+                        stop = Tokens()->TokenArray(s);
                     }
                     if (s->IsOpen()) {
                         if (!callbacks_) {
@@ -657,11 +1253,7 @@ public:
                         ac++;
                     }else {
                         if (!callbacks_) {
-                            auto nsa = reinterpret_cast<JSONArray<LENGTH>*>(s->Next());    // Array or Map, same properties
-
-                            // If next and (next is map or array and open) or next is string
-                            if (s->Next() && (((JSONElement<LENGTH>::ARRAY == s->Next()->Type() || JSONElement<LENGTH>::MAP == s->Next()->Type())
-                                                    && nsa->IsOpen()) || JSONElement<LENGTH>::STRING == s->Next()->Type())) {
+                            if (IsItem(s->Next())) {
                                 wr_err |= io_->Append(" ], ");
                             }else {
                                 wr_err |= io_->Append(" ]");
@@ -677,7 +1269,7 @@ public:
                     auto s = reinterpret_cast<JSONMap<LENGTH>*>(e);
 
                     if (callbacks_) {
-                        stop = TokenMap(s);
+                        stop = Tokens()->TokenMap(s);
                     }
                     if (s->IsOpen()) {
 
@@ -695,11 +1287,7 @@ public:
                         mc++;
                     }else {
                         if (!callbacks_) {
-                            auto nsa = reinterpret_cast<JSONArray<LENGTH>*>(s->Next());    // Array or Map, same properties
-
-                            // If next and (next is map or array and open) or next is string
-                            if (s->Next() && (((JSONElement<LENGTH>::ARRAY == s->Next()->Type() || JSONElement<LENGTH>::MAP == s->Next()->Type())
-                                                    && nsa->IsOpen()) || JSONElement<LENGTH>::STRING == s->Next()->Type())) {
+                            if (IsItem(s->Next())) {
                                 wr_err |= io_->Append(" }, ");
                             }else {
                                 wr_err |= io_->Append(" }");
@@ -711,11 +1299,56 @@ public:
                 }
                 break;
 
+                case JSONElement<LENGTH>::NUMBERS : {
+                    auto s = reinterpret_cast<JSONNumbers<LENGTH>*>(e);
+
+                    if (!callbacks_) {
+                        if (last_e_ && JSONElement<LENGTH>::STRING == last_e_->Type()) {
+                            auto ls = reinterpret_cast<JSONString<LENGTH>*>(last_e_);
+
+                            if (ls->IsValue()) {
+                                wr_err |= io_->Append(", ");
+                            }
+                        }
+                        wr_err |= AppendNumbers(s);
+                        if (IsItem(s->Next())) {
+                            wr_err |= io_->Append(", ");
+                        }
+                    }
+                }
+                break;
+
+                case JSONElement<LENGTH>::RAW : {
+                    auto s = reinterpret_cast<JSONRaw<LENGTH>*>(e);
+
+                    if (!callbacks_) {
+                        if (s->IsItemStart() && last_e_ && JSONElement<LENGTH>::STRING == last_e_->Type()) {
+                            auto ls = reinterpret_cast<JSONString<LENGTH>*>(last_e_);
+
+                            if (ls->IsValue()) {
+                                wr_err |= io_->Append(", ");
+                            }
+                        }
+                        wr_err |= io_->Append(s->Data(), s->Length());
+                        if (s->IsItemEnd() && IsItem(s->Next())) {
+                            wr_err |= io_->Append(", ");
+                        }
+                    }
+
+                    // Text opens and closes, as the elements it stands for
+                    ac += s->Arrays();
+                    mc += s->Maps();
+                }
+                break;
+
+                case JSONElement<LENGTH>::KEY :
                 case JSONElement<LENGTH>::STRING : {
-                    auto s = reinterpret_cast<JSONString<LENGTH>*>(e);
+                    auto s = KeyString(e, &ks);
 
-                    if (callbacks_) {
-                        stop = TokenString(s);
+                    if (!s) {
+                        last_error_ = ERR_BAD_ATTRIBUTE;    // No intern table or unknown identifier
+                    }else if (callbacks_) {
+                        stop = Tokens()->TokenString(s);
                     }else {
                         if (last_e_ && JSONElement<LENGTH>::STRING == last_e_->Type()) {
                             auto ls = reinterpret_cast<JSONString<LENGTH>*>(last_e_);
@@ -730,19 +1363,18 @@ public:
                             if (!s->IsValue()) {
                                 // Has data
                                 wr_err |= io_->Append("\"");
-                                wr_err |= io_->Append(s->Data());
+                                wr_err |= JSONSupport::AppendEscaped(io_, s->Data());
                                 if (s->IsValue()) {
                                     wr_err |= io_->Append("\", ");
                                 }else {
                                     wr_err |= io_->Append("\":");
                                 }
                             }else {
-								printf("v: %s\n", s->Data());
                                 if (s->IsValueLiteral()) {
                                     wr_err |= io_->Append(s->Data());
                                 }else {
                                     wr_err |= io_->Append("\"");
-                                    wr_err |= io_->Append(s->Data());
+                                    wr_err |= JSONSupport::AppendEscaped(io_, s->Data());
                                     wr_err |= io_->Append("\"");
                                 }
                             }
@@ -750,6 +1382,9 @@ public:
                     }
                 }
                 break;
+
+                case JSONElement<LENGTH>::NOTSET :
+                break;
             } // switch(e->Type())
             last_e_ = e;
 
@@ -786,11 +1421,131 @@ public:
         } // while(e)
         last_e_ = NULL;
         io_->Append('\0');    // Ignore write error
-
+        StatsPhase(JSONParseStats::PHASE_OUTPUT, t);
+        GJSON_TRACE_END("FromObject", io_->GetLength(), n);
 
         return (ERR_NONE == last_error_) ? true : false;
     } // FromObjects(...)
 
+
+    /**
+     * Parse given JSON object chain built by \ref FromString of JSON string s, build JSON string in I/O object 
+     * copying runs of unchanged elements straight from s and writing only changed (dirty) elements.  For read, 
+     * modify and write of a few values of a large JSON string.
+     *
+     * Elements keep their source spans with \ref GJSON_SOURCE_SPANS, setting string data or \ref JSONElement::Dirty 
+     * drops one, new elements have none.  A run continues while the text of s between one element and the next is 
+     * only white space, commas and colons, so removed or reordered elements end a run.  Written elements are 
+     * separated compactly, copied runs keep the formatting of s.
+     *
+     * \attention s must be JSON string object chain was parsed from, unchanged, and not the I/O of this parser.  No 
+     * callbacks are made
+     *
+     * \note Without \ref GJSON_SOURCE_SPANS every element is dirty and the whole chain is written
+     *
+     * \note With \ref LimitNodeLevel an object chain ending before its arrays and maps close, as left by 
+     * \ref FromString failing part way (e.g. ERR_OBJECT_MEMORY_LIMIT), fails with ERR_UNEXPECTED_END_OF_ARRAY 
+     * or ERR_UNEXPECTED_END_OF_MAP
+     *
+     * \param[in] e Pointer to first JSON element in object chain
+     * \param[in] s JSON string object chain was parsed from, NULL terminated
+     * \retval true Success
+     * \retval false Failure, check \ref GetLastError.  I/O is left empty
+     */
+    bool FromObjectIncremental(JSONElement<LENGTH>* e, const char* s) {
+        bool wr_err = false;
+        int16_t ac = 0, mc = 0;
+        uint16_t n = 0, rs = 0, re = 0;    // Run of s pending copy, rs to re
+        JSONString<LENGTH> ks(false);    // Interned attribute/property
+        uint32_t t = StatsClock();
+
+        GJSON_TRACE_BEGIN("FromObjectIncremental", 0);
+        last_e_ = NULL;
+        like_ = NULL;
+        last_error_ = ERR_NONE;
+        operation_ = OP_FROM_OBJECT;
+        io_->Length(0);
+        while(e) {
+            uint16_t so = e->SourceOffset();
+
+            n++;
+            if (!e->IsDirty() && rs < re && so >= re && IsSeparators(&s[re], so - re)) {
+                re = so + e->SourceLength();    // Run continues
+            }else {
+                if (rs < re) {
+                    wr_err |= io_->Append(&s[rs], re - rs);
+                    rs = re = 0;
+                }
+                if (last_e_ && IsItem(e)) {
+                    wr_err |= AppendSeparator(last_e_);
+                }
+                if (!e->IsDirty()) {
+                    rs = so;    // Run begins
+                    re = so + e->SourceLength();
+                }else {
+                    wr_err |= AppendElement(e, &ks);
+                }
+            }
+            last_e_ = e;
+            if (!last_error_ && wr_err) {
+                last_error_ = ERR_CHAR_MEMORY_LIMIT;
+            }
+            if (ERR_NONE != last_error_) {
+                break;
+            }
+
+            switch(e->Type()) {
+                case JSONElement<LENGTH>::ARRAY :
+                    ac += reinterpret_cast<JSONArray<LENGTH>*>(e)->IsOpen() ? 1 : -1;
+                break;
+
+                case JSONElement<LENGTH>::MAP :
+                    mc += reinterpret_cast<JSONMap<LENGTH>*>(e)->IsOpen() ? 1 : -1;
+                break;
+
+                case JSONElement<LENGTH>::RAW :
+                    ac += reinterpret_cast<JSONRaw<LENGTH>*>(e)->Arrays();
+                    mc += reinterpret_cast<JSONRaw<LENGTH>*>(e)->Maps();
+                break;
+
+                default :
+                break;
+            }
+            if (limit_node_level_) {
+                if (ac<0) {
+                    last_error_ = ERR_UNEXPECTED_END_OF_ARRAY;
+                    break;
+                }
+                if (mc<0) {
+                    last_error_ = ERR_UNEXPECTED_END_OF_MAP;
+                    break;
+                }
+                // Have we reached the base of where we started parsing?
+                if (mc==0 && ac==0) {
+                    break;
+                }
+            }
+
+            e = e->Next();
+        } // while(e)
+        if (ERR_NONE == last_error_ && limit_node_level_ && (ac || mc)) {
+            // Object chain ended with arrays or maps open, truncated
+            last_error_ = ac ? ERR_UNEXPECTED_END_OF_ARRAY : ERR_UNEXPECTED_END_OF_MAP;
+        }
+        if (ERR_NONE == last_error_ && rs < re && io_->Append(&s[rs], re - rs)) {
+            last_error_ = ERR_CHAR_MEMORY_LIMIT;
+        }
+        if (ERR_NONE != last_error_) {
+            io_->Length(0);    // No partial JSON string
+        }
+        last_e_ = NULL;
+        io_->Append('\0');    // Ignore write error
+        StatsPhase(JSONParseStats::PHASE_OUTPUT, t);
+        GJSON_TRACE_END("FromObjectIncremental", io_->GetLength(), n);
+
+        return (ERR_NONE == last_error_) ? true : false;
+    } // FromObjectIncremental(...)
+
     
     /**
      * Parse given JSON object chain looking for an object previously setup via \ref Like
@@ -805,11 +1560,17 @@ public:
     JSONElement<LENGTH>* FindObject(JSONElement<LENGTH>* e) {
         int16_t ac = 0, mc = 0;
         JSONElement<LENGTH>* f = NULL;
+        uint16_t n = 0;
+        JSONString<LENGTH> ks(false);    // Interned attribute/property
+        bool marked = false;
+        uint32_t t = StatsClock();
 
+        GJSON_TRACE_BEGIN("FindObject", 0);
         last_e_ = NULL;
         last_error_ = ERR_NONE;
         operation_ = OP_FIND_OBJECT;
         while(e) {
+            n++;
             switch(e->Type()) {
                 case JSONElement<LENGTH>::ARRAY : {
                     auto s = reinterpret_cast<JSONArray<LENGTH>*>(e);
@@ -820,7 +1581,7 @@ public:
                         ac--;
                     }
                     if (callbacks_) {
-                        if (TokenArray(s)) {
+                        if (Tokens()->TokenArray(s)) {
                             f = e;
                             break;
                         }
@@ -847,7 +1608,7 @@ public:
                     }
                     if (callbacks_) {
 
-                        if (TokenMap(s)) {
+                        if (Tokens()->TokenMap(s)) {
                             f = e;
                             break;
                         }
@@ -868,7 +1629,7 @@ public:
                     auto s = reinterpret_cast<JSONString<LENGTH>*>(e);
 
                     if (callbacks_) {
-                        if (TokenString(s)) {
+                        if (Tokens()->TokenString(s)) {
                             f = e;
                             break;
                         }
@@ -899,6 +1660,48 @@ public:
                     }
                 }
                 break;
+
+                case JSONElement<LENGTH>::KEY : {
+                    auto k = reinterpret_cast<JSONKey<LENGTH>*>(e);
+
+                    if (callbacks_) {
+                        auto s = KeyString(e, &ks);
+
+                        if (s && Tokens()->TokenString(s)) {
+                            f = e;
+                            break;
+                        }
+                    }else {
+                        if (intern_ && like_ && JSONElement<LENGTH>::STRING == like_->Type()) {
+                            auto l = reinterpret_cast<JSONString<LENGTH>*>(like_);
+
+                            if (!l->IsValue()) {
+                                // Table strings compared once per search, each element is then a mark test
+                                if (!marked) {
+                                    intern_->Mark(l->Data(), l->Length(), case_sensitive_);
+                                    marked = true;
+                                }
+                                if (intern_->IsMarked(k->Id())) {
+                                    f = e;
+                                    break;
+                                }
+                            }
+                        }
+                    }
+                }
+                break;
+
+                case JSONElement<LENGTH>::RAW : {
+                    auto s = reinterpret_cast<JSONRaw<LENGTH>*>(e);
+
+                    ac += s->Arrays();
+                    mc += s->Maps();
+                }
+                break;
+
+                case JSONElement<LENGTH>::NUMBERS :    // Whole array, balanced and holding no strings
+                case JSONElement<LENGTH>::NOTSET :
+                break;
             } // switch(e->Type())
             last_e_ = e;
 
@@ -924,6 +1727,8 @@ public:
         if (!f && ERR_NONE == last_error_) {
             last_error_ = ERR_NOT_FOUND;
         }
+        StatsPhase(JSONParseStats::PHASE_FIND, t);
+        GJSON_TRACE_END("FindObject", 0, n);
 
         return f;
     } // FindObject(...)
@@ -982,7 +1787,7 @@ public:
      * \param[in] e Pointer to first JSON element in object chain
      * \param[in] is_value String must be a value(true, default) or property/attribute 
      * type(false)
-     * \return Found element pointer or NULL (not found)
+     * \return Found element pointer or NULL (not found).  Interned attribute/property is a copy, see \ref FindString
      */
     JSONString<LENGTH>* NextString(JSONElement<LENGTH>* e, bool is_value=true) {
         JSONString<LENGTH>* fe = NULL;
@@ -992,7 +1797,7 @@ public:
         if (e) {
             auto m = JSONString<LENGTH>(is_value);
             Like(&m);
-            fe = reinterpret_cast<JSONString<LENGTH>*>(FindObject(e->Next()));
+            fe = FoundString(FindObject(e->Next()));
         }
 
         return fe;
@@ -1011,6 +1816,10 @@ public:
      * \param[in] case_sensitive Flag indicating search should be case sensitive, default
      * false
      * \return Found element pointer or NULL (not found)
+     *
+     * \note When found attribute/property is interned, see \ref Intern, a copy held by the parser is given 
+     * instead, valid until the next search.  Its next element is that of the interned element so the value 
+     * follows as usual
      */
     JSONString<LENGTH>* FindString(JSONElement<LENGTH>* e, char *s, bool is_value=true, const bool case_sensitive=false) {
         JSONString<LENGTH>* fe = NULL;
@@ -1020,7 +1829,7 @@ public:
         if (e) {
             auto m = JSONString<LENGTH>(s, is_value);
             Like(&m, case_sensitive);
-            fe = reinterpret_cast<JSONString<LENGTH>*>(FindObject(e));
+            fe = FoundString(FindObject(e));
         }
 
         return fe;
@@ -1030,12 +1839,12 @@ public:
     /**
      * Get or set object chain creation memory limit (Bytes)
      *
-     * \note Read required memory via \ref GetBinarySize
+     * \note Read required memory via \ref GetBinarySize or before parsing \ref Estimate
      *
      * \param[in] limit_memory Bytes.  Default 0 implies read only, otherwise set and read
      * \return Memory limit, Bytes.  If not updated then new value not accepted
      */
-    uint16_t MemoryLimit(const uint16_t limit_memory=0) {
+    uint32_t MemoryLimit(const uint32_t limit_memory=0) {
         if (limit_memory) {
             limit_memory_ = limit_memory;
         }
@@ -1044,6 +1853,60 @@ public:
     }
 
 
+    /**
+     * Set attribute/property intern table.  Object chains then built by \ref FromString hold each distinct 
+     * attribute/property string once in the table and \ref JSONKey elements of its identifier, and attribute/property 
+     * searches compare table strings once rather than every element.  NULL (default) for plain strings
+     *
+     * \attention Table must outlive every object chain built with it and be set whenever such a chain is given 
+     * to \ref FromObject or \ref FindObject.  \ref Estimate sizes without interning, an upper bound
+     *
+     * \note Callbacks are always given attribute/properties as \ref JSONString.  When table is full further 
+     * distinct attribute/properties are plain strings
+     *
+     * \param[in] intern Pointer to intern table or NULL (none)
+     */
+    void Intern(JSONIntern<LENGTH>* intern) {
+        intern_ = intern;
+    }
+
+
+    /**
+     * Get attribute/property intern table
+     *
+     * \return Pointer to intern table or NULL (none)
+     */
+    JSONIntern<LENGTH>* Intern() const {
+        return intern_;
+    }
+
+
+    /**
+     * Set element pool.  Object chains built by \ref FromString then take array, map and string elements from 
+     * the pool free lists and \ref Release gives elements back to them, so a parse and release cycle repeated 
+     * with alike JSON strings goes to the heap only until lists hold enough.  NULL (default) for heap, by 
+     * \ref GJSON_NEW_OBJECT and \ref GJSON_RELEASE_OBJECT
+     *
+     * \attention Pool must outlive every object chain built with it, or chains be released while it is set.  Chains 
+     * built with a pool may be released by it (\ref JSONNodePool::ReleaseChain) and built without one released to it
+     *
+     * \param[in] pool Pointer to element pool or NULL (none)
+     */
+    void Pool(JSONNodePool<LENGTH>* pool) {
+        pool_ = pool;
+    }
+
+
+    /**
+     * Get element pool
+     *
+     * \return Pointer to element pool or NULL (none)
+     */
+    JSONNodePool<LENGTH>* Pool() const {
+        return pool_;
+    }
+
+
     /**
      * Setup JSON element to find by \ref FindObject
      *
@@ -1068,6 +1931,17 @@ public:
     }
 
 
+    /**
+     * Set validate UTF-8 flag.  String parsing checks attribute/property and value strings are 
+     * valid UTF-8 as they are scanned, raising ERR_BAD_ENCODING otherwise
+     *
+     * \param[in] validate_utf8 Flag state, default true
+     */
+    void ValidateUTF8(const bool validate_utf8=true) {
+        validate_utf8_ = validate_utf8;
+    }
+
+
     /**
      * Set Callbacks flag indicating use of callbacks.  This is used by parsing both 
      * object and character JSON.  By default callbacks are not implemented within this class
@@ -1094,6 +1968,25 @@ public:
 	}
 
 
+    /**
+     * Set pack numbers flag.  Object chains built by \ref FromString then hold each array of only numeric literals 
+     * as one \ref JSONNumbers element, a vector of 32 bit integers, 64 bit integers when any is out of 32 bit 
+     * range, or decimals when any is a decimal.  Memory needed is a fraction of an element per number
+     *
+     * \note \ref FromObject writes decimals by "%.7g" (single) or "%.15g", so values round trip but not their text, 
+     * e.g. 1.0 is written 1 and 2.50 as 2.5
+     *
+     * \note Packing doesn't apply while callbacks are employed, see \ref Callbacks
+     *
+     * \param[in] pack_numbers Flag state, default true
+     * \param[in] pack_float Flag indicating decimals are packed single precision, default false (double)
+     */
+    void PackNumbers(const bool pack_numbers=true, const bool pack_float=false) {
+        pack_numbers_ = pack_numbers;
+        pack_float_ = pack_float;
+    }
+
+
     /**
      * Get last JSON parse or find error condition (if any).  For list see enum \ref ERR
      *
@@ -1126,6 +2019,20 @@ public:
         return binary_size_;
     }
 
+#if GJSON_STATS
+
+    /**
+     * Get statistics of last string parse and any object chain output, find and release since, see \ref JSONParseStats
+     *
+     * \note Only with build macro \ref GJSON_STATS set
+     *
+     * \return Statistics
+     */
+    const JSONParseStats& GetStats() const {
+        return stats_;
+    }
+#endif // GJSON_STATS
+
 
     /**
      * Get I/O object data length, see \ref gjson::IO::GetLength
@@ -1162,21 +2069,31 @@ public:
         // deref head_ref to get the real head
         JSONElement<LENGTH>* c = *h;
         JSONElement<LENGTH>* n;
+        uint16_t k = 0;
+        uint32_t t = StatsClock();
 
+        GJSON_TRACE_BEGIN("Release", 0);
         // Deref any internals
         Like(NULL);
         last_e_ = NULL;
 
         operation_ = OP_RELEASE_OBJECT;
-        uint16_t rt = 0;
         while(c != NULL) {
             n = c->Next();  
-            GJSON_RELEASE_OBJECT( c );
+            StatsFree(c);
+            if (pool_) {
+                pool_->Release(c);
+            }else {
+                JSONNodePool<LENGTH>::Free(c);
+            }
             c = n;
+            k++;
         }
       
         // Deref head_ref to affect the real head back in the caller
         *h = NULL;  
+        StatsPhase(JSONParseStats::PHASE_RELEASE, t);
+        GJSON_TRACE_END("Release", 0, k);
     }
 
 protected:
@@ -1186,14 +2103,18 @@ protected:
      *
      * \return Literal character state
      */
-    bool IsLiteralCharater(char c) {
-        const char literals[] = "0123456789.-+eEnultrfas";    // Digits, signs, decimal point and alphas for true, false and null
-        uint16_t i;
-        bool lc = false;
+    static bool IsLiteralCharater(char c) {
+        bool lc = (c >= '0' && c <= '9');
+
+        if (!lc) {
+            // Signs, decimal point and alphas for true, false and null
+            switch(c) {
+                case '.' : case '-' : case '+' : case 'e' : case 'E' :
+                case 'n' : case 'u' : case 'l' : case 't' : case 'r' : case 'f' : case 'a' : case 's' :
+                    lc = true;
+                break;
 
-        for(i=0; i<sizeof(literals); i++) {
-            if (c == literals[i]) {
-                lc = true;
+                default :
                 break;
             }
         }
@@ -1213,69 +2134,697 @@ protected:
     }
 
 
+    typedef typename JSONTokenPolicy<LENGTH, JSONParse<LENGTH, H, I>, H>::TokenHandler TokenHandler;    ///< Type implementing callbacks
+
+
     /**
-     * Helper to set error condition
+     * Helper to get callback handler, this parser or subclass given as handler type
      *
-     * \param[in] error Error condition code, \ref ERR
+     * \return Handler pointer
      */
-    void Error(const ERR error) {
-        last_error_ = error;
+    TokenHandler* Tokens() {
+#if GJSON_STATS
+        stats_.callbacks++;    // Only used to invoke callbacks
+#endif // GJSON_STATS
+        GJSON_TRACE_EVENT("Callback", operation_, Depth());
+        return static_cast<TokenHandler*>(this);
     }
 
 
-protected:
-    ERR         last_error_;                ///< Last error
-    OP          operation_;                 ///< Current operation
-    uint16_t    binary_size_;               ///< Size of binary, Bytes
-    uint16_t    limit_memory_;              ///< Limit of memory, Bytes
-    IO*         io_;                        ///< IO instance pointer
-    bool        limit_node_level_;          ///< Limit node level flag
-    bool        callbacks_;                 ///< Callbacks employed flag
-    bool        case_sensitive_;            ///< Case sensitive checks flag
-    JSONElement<LENGTH>* last_e_;           ///< Last element processed pointer
-    JSONElement<LENGTH>* like_;             ///< Search like element pointer
-}; // class JSONParse
-
-
-/**
- * JSON non-recursive string parser by subclass for searching and replacing JSON string attributes/properties in Maps.  Uses user supplied
- * I/O as source of JSON string.
- *
- * \tparam LENGTH Maximum length (including NULL terminator) in characters of a string attribute/property
- */
-template<uint8_t LENGTH>
-class JSONSimpleStringParseAttr : protected JSONParse<LENGTH> {
-public:
     /**
-     * \copydoc JSONParse::ERR
+     * Helper to get size of element
+     *
+     * \param[in] e Pointer to element
+     * \return Bytes
      */
-    using JSONParse<LENGTH>::ERR;
+    static uint32_t ElementSize(JSONElement<LENGTH>* e) {
+        uint32_t sz = sizeof(JSONString<LENGTH>);
+
+        if (JSONElement<LENGTH>::ARRAY == e->Type()) {
+            sz = sizeof(JSONArray<LENGTH>);
+        }else if (JSONElement<LENGTH>::MAP == e->Type()) {
+            sz = sizeof(JSONMap<LENGTH>);
+        }else if (JSONElement<LENGTH>::KEY == e->Type()) {
+            sz = sizeof(JSONKey<LENGTH>);
+        }else if (JSONElement<LENGTH>::RAW == e->Type()) {
+            sz = sizeof(JSONRaw<LENGTH>);
+        }else if (JSONElement<LENGTH>::NUMBERS == e->Type()) {
+            auto a = reinterpret_cast<JSONNumbers<LENGTH>*>(e);
+
+            sz = sizeof(JSONNumbers<LENGTH>) + static_cast<uint32_t>(a->Count()) * JSONNumbers<LENGTH>::Size(a->Kind());
+        }
+
+        return sz;
+    }
 
 
     /**
-     * \copydoc JSONParse::GetLastError
+     * Helper to query JSON text holds only separators, white space, commas and colons
+     *
+     * \param[in] s JSON text
+     * \param[in] l Text length, characters
+     * \return Boolean
+     */
+    static bool IsSeparators(const char* s, const uint16_t l) {
+        for(uint16_t i=0; i<l; i++) {
+            switch(s[i]) {
+                case ' ' : case '\t' : case '\r' : case '\n' : case ',' : case ':' :
+                break;
+
+                default :
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+
+    /**
+     * Helper to write separator after element, of an element starting an item.  Colon after attribute/property, 
+     * comma after a value, nothing after array or map open
+     *
+     * \param[in] e Pointer to element before
+     * \retval true Write error
+     * \retval false Success
+     */
+    bool AppendSeparator(JSONElement<LENGTH>* e) {
+        switch(e->Type()) {
+            case JSONElement<LENGTH>::KEY :
+            return io_->Append(':');
+
+            case JSONElement<LENGTH>::STRING :
+            return io_->Append(reinterpret_cast<JSONString<LENGTH>*>(e)->IsValue() ? ',' : ':');
+
+            case JSONElement<LENGTH>::ARRAY :
+            case JSONElement<LENGTH>::MAP :
+                if (reinterpret_cast<JSONArray<LENGTH>*>(e)->IsOpen()) {
+                    return false;
+                }
+            break;
+
+            case JSONElement<LENGTH>::RAW :
+                if (!reinterpret_cast<JSONRaw<LENGTH>*>(e)->IsItemEnd()) {
+                    return false;
+                }
+            break;
+
+            default :
+            break;
+        }
+
+        return io_->Append(',');
+    } // AppendSeparator(...)
+
+
+    /**
+     * Helper to write element alone, without separators
+     *
+     * \param[in] e Pointer to element
+     * \param[in,out] ks Pointer to string element for interned attribute/property
+     * \retval true Write error
+     * \retval false Success or bad attribute/property, check last error
+     */
+    bool AppendElement(JSONElement<LENGTH>* e, JSONString<LENGTH>* ks) {
+        switch(e->Type()) {
+            case JSONElement<LENGTH>::ARRAY :
+            return io_->Append(reinterpret_cast<JSONArray<LENGTH>*>(e)->IsOpen() ? '[' : ']');
+
+            case JSONElement<LENGTH>::MAP :
+            return io_->Append(reinterpret_cast<JSONMap<LENGTH>*>(e)->IsOpen() ? '{' : '}');
+
+            case JSONElement<LENGTH>::NUMBERS :
+            return AppendNumbers(reinterpret_cast<JSONNumbers<LENGTH>*>(e));
+
+            case JSONElement<LENGTH>::RAW : {
+                auto r = reinterpret_cast<JSONRaw<LENGTH>*>(e);
+
+                return io_->Append(r->Data(), r->Length());
+            }
+
+            case JSONElement<LENGTH>::KEY :
+            case JSONElement<LENGTH>::STRING : {
+                auto s = KeyString(e, ks);
+                bool wr_err = false;
+
+                if (!s) {
+                    last_error_ = ERR_BAD_ATTRIBUTE;    // No intern table or unknown identifier
+                }else if (s->IsValue() && s->IsValueLiteral()) {
+                    wr_err |= io_->Append(s->Data());
+                }else {
+                    wr_err |= io_->Append('\"');
+                    wr_err |= JSONSupport::AppendEscaped(io_, s->Data());
+                    wr_err |= io_->Append('\"');
+                }
+
+                return wr_err;
+            }
+
+            default :
+            break;
+        }
+
+        return false;
+    } // AppendElement(...)
+
+
+    /**
+     * Helper to query element starts a further item of array or map, so is comma separated from element before
+     *
+     * \param[in] e Pointer to element or NULL
+     * \return Boolean
+     */
+    static bool IsItem(JSONElement<LENGTH>* e) {
+        if (!e) {
+            return false;
+        }
+        if (JSONElement<LENGTH>::ARRAY == e->Type() || JSONElement<LENGTH>::MAP == e->Type()) {
+            return reinterpret_cast<JSONArray<LENGTH>*>(e)->IsOpen();    // Array or Map, same properties
+        }
+        if (JSONElement<LENGTH>::RAW == e->Type()) {
+            return reinterpret_cast<JSONRaw<LENGTH>*>(e)->IsItemStart();
+        }
+
+        return (JSONElement<LENGTH>::NOTSET != e->Type());
+    }
+
+
+    /**
+     * Helper to classify array at string index for packing, see \ref Numbers
+     *
+     * \param[in] s JSON source string
+     * \param[in] i Character index of array open
+     * \param[in] l JSON source string length (characters)
+     * \param[out] j Character index of array close, only valid when packable
+     * \param[out] c Numbers count, only valid when packable
+     * \param[out] kind Smallest number kind holding all, only valid when packable
+     * \retval true Packable, only numeric literals separated by commas
+     * \retval false Not packable
+     */
+    bool NumbersKind(const char* s, const uint16_t i, const uint16_t l, uint16_t& j, uint16_t& c, 
+                    typename JSONNumbers<LENGTH>::KIND& kind) const {
+        typedef JSONNumbers<LENGTH> N;
+        uint16_t ts;
+        bool sep = true;    // Number expected
+        int64_t v = 0;
+
+        kind = N::INT32;
+        c = 0;
+        for(j=i+1; j<l && ']' != s[j]; j++) {
+            if (' ' == s[j] || '\t' == s[j]) {
+                continue;
+            }
+            if (',' == s[j]) {
+                if (sep) {
+                    return false;
+                }
+                sep = true;
+                continue;
+            }
+            if (!sep || !IsLiteralCharater(s[j])) {
+                return false;
+            }
+            for(ts=j; j<l && IsLiteralCharater(s[j]); j++);
+            if (JSONSupport::IsInt(&s[ts], j - ts) && JSONSupport::ToInt(&s[ts], j - ts, v)) {
+                if (N::INT32 == kind && (v < -2147483647L - 1 || v > 2147483647L)) {
+                    kind = N::INT64;
+                }
+            }else if (JSONSupport::IsDecimal(&s[ts], j - ts, GJSON_DEFAULT_EXPONENTIAL_NOTATION)) {
+                kind = pack_float_ ? N::FLOAT : N::DOUBLE;
+            }else {
+                return false;    // true, false, null or not a literal
+            }
+            j--;
+            c++;
+            sep = false;
+        }
+
+        return (j<l && !sep);    // Not unterminated, empty or trailing comma
+    } // NumbersKind(...)
+
+
+    /**
+     * Helper to build packed numbers element of array at string index, see \ref PackNumbers.  Array must hold only 
+     * numeric literals separated by commas, otherwise it is left to usual parsing
+     *
+     * \param[in] s JSON source string
+     * \param[in,out] i Character index of array open, updated to array close when packed
+     * \param[in] l JSON source string length (characters)
+     * \param[in] e Pointer, parent element or NULL
+     * \return Element pointer or NULL, not packed.  Check last error, ERR_OBJECT_MEMORY_LIMIT when out of memory, 
+     * ERR_BAD_VALUE bad integer literal
+     */
+    JSONNumbers<LENGTH>* Numbers(const char* s, uint16_t& i, const uint16_t l, JSONElement<LENGTH>* e) {
+        typedef JSONNumbers<LENGTH> N;
+        typename N::KIND kind;
+        N* a = NULL;
+        uint64_t* d;
+        uint16_t j, k, ts, c;
+        int64_t v = 0;
+
+        if (!NumbersKind(s, i, l, j, c, kind)) {
+            return NULL;
+        }
+
+        if (limit_memory_ < binary_size_ + sizeof(N) + static_cast<uint32_t>(c) * N::Size(kind)) {
+            last_error_ = ERR_OBJECT_MEMORY_LIMIT;
+            return NULL;
+        }
+        d = GJSON_NEW_ARRAY( uint64_t, (static_cast<uint32_t>(c) * N::Size(kind) + 7) / 8 );
+        if (d) {
+            a = GJSON_NEW_OBJECT( N(kind, d, c), N );
+            if (!a) {
+                GJSON_RELEASE_ARRAY( d );
+            }
+        }
+        if (!a) {
+            last_error_ = ERR_OBJECT_MEMORY_LIMIT;
+            return NULL;
+        }
+
+        for(k=0, i++; i<j; i++) {
+            if (IsLiteralCharater(s[i])) {
+                bool ok = true;
+
+                for(ts=i; IsLiteralCharater(s[i]); i++);
+                switch(kind) {
+                    case N::INT32 : ok = JSONSupport::ToInt(&s[ts], i - ts, v); a->Int32()[k++] = static_cast<int32_t>(v); break;
+                    case N::INT64 : ok = JSONSupport::ToInt(&s[ts], i - ts, a->Int64()[k++]); break;
+                    case N::FLOAT : a->Float()[k++] = static_cast<float>(atof(&s[ts])); break;
+                    default : a->Double()[k++] = atof(&s[ts]); break;
+                }
+                if (!ok) {
+                    JSONNodePool<LENGTH>::Free(a);
+                    last_error_ = ERR_BAD_VALUE;
+                    return NULL;
+                }
+            }
+        }
+        if (!Linked(a, e)) {
+            return NULL;
+        }
+        i = j;
+
+        return a;
+    } // Numbers(...)
+
+
+    /**
+     * Helper to append packed numbers element to I/O as JSON array
+     *
+     * \param[in] a Pointer to packed numbers element
+     * \retval true Write error
+     * \retval false Success
+     */
+    bool AppendNumbers(JSONNumbers<LENGTH>* a) {
+        bool wr_err = io_->Append("[ ");
+        char b[24];
+
+        for(uint16_t k=0; k<a->Count(); k++) {
+            if (k) {
+                wr_err |= io_->Append(", ");
+            }
+            switch(a->Kind()) {
+                case JSONNumbers<LENGTH>::INT32 : wr_err |= io_->Append(JSONSupport::IntString(b, a->Int32()[k])); break;
+                case JSONNumbers<LENGTH>::INT64 : wr_err |= io_->Append(JSONSupport::IntString(b, a->Int64()[k])); break;
+                case JSONNumbers<LENGTH>::FLOAT : snprintf(b, sizeof(b), "%.7g", static_cast<double>(a->Float()[k])); wr_err |= io_->Append(b); break;
+                default : snprintf(b, sizeof(b), "%.15g", a->Double()[k]); wr_err |= io_->Append(b); break;
+            }
+        }
+        wr_err |= io_->Append(" ]");
+
+        return wr_err;
+    } // AppendNumbers(...)
+
+
+    /**
+     * Helper to get string element of attribute/property or value element, interned attribute/property copied 
+     * from table
+     *
+     * \param[in] e Pointer to string or interned attribute/property element
+     * \param[out] ks Pointer to string element taking interned attribute/property
+     * \return String element pointer, e or ks.  NULL when interned and no table or unknown identifier
+     */
+    JSONString<LENGTH>* KeyString(JSONElement<LENGTH>* e, JSONString<LENGTH>* ks) {
+        if (JSONElement<LENGTH>::KEY != e->Type()) {
+            return reinterpret_cast<JSONString<LENGTH>*>(e);
+        }
+
+        return (intern_ && intern_->Key(reinterpret_cast<JSONKey<LENGTH>*>(e)->Id(), ks)) ? ks : NULL;
+    }
+
+
+    /**
+     * Helper to give found string element.  Interned attribute/property is copied into parser held string 
+     * linked to its next element, reused as attribute/properties are interned by \ref FromString
+     *
+     * \param[in] e Pointer to found element or NULL
+     * \return String element pointer or NULL
+     */
+    JSONString<LENGTH>* FoundString(JSONElement<LENGTH>* e) {
+        if (e && JSONElement<LENGTH>::KEY == e->Type()) {
+            // Allocated as elements are so relative links of compact elements reach
+            if (!key_) {
+                key_ = GJSON_NEW_OBJECT( JSONString<LENGTH>(false), JSONString<LENGTH> );
+            }
+            if (!key_ || !KeyString(e, key_)) {
+                return NULL;
+            }
+            key_->Next(e->Next());
+
+            return key_;
+        }
+
+        return reinterpret_cast<JSONString<LENGTH>*>(e);
+    }
+
+
+    /**
+     * Statistics helper, get clock at start of phase.  Without \ref GJSON_STATS nothing
+     *
+     * \return Clock count
+     */
+    uint32_t StatsClock() const {
+#if GJSON_STATS
+        return GJSON_STATS_CLOCK();
+#else
+        return 0;
+#endif // GJSON_STATS
+    }
+
+
+    /**
+     * Statistics helper, reset for new string parse carrying over element bytes still allocated.  Without 
+     * \ref GJSON_STATS nothing
+     */
+    void StatsReset() {
+#if GJSON_STATS
+        uint32_t ob = stats_.object_bytes;
+
+        stats_.Reset();
+        stats_.object_bytes = stats_.peak_object_bytes = ob;
+#endif // GJSON_STATS
+    }
+
+
+    /**
+     * Statistics helper, record end of phase.  Without \ref GJSON_STATS nothing
+     *
+     * \param[in] p Phase
+     * \param[in] t Clock count at start of phase, see \ref StatsClock
+     * \param[in] bytes Characters scanned, default 0
+     */
+    void StatsPhase(const JSONParseStats::PHASE p, const uint32_t t, const uint16_t bytes=0) {
+#if GJSON_STATS
+        stats_.time[p] += GJSON_STATS_CLOCK() - t;
+        stats_.bytes += bytes;
+#endif // GJSON_STATS
+    }
+
+
+    /**
+     * Statistics helper, record parsed token.  Without \ref GJSON_STATS only token count
+     *
+     * \param[in] e Pointer to element of token
+     * \param[in] allocated Element was allocated flag
+     * \param[in] depth Relative nesting depth
+     * \param[in,out] n Tokens of this parse, incremented for \ref GJSON_TRACE_END
+     */
+    void StatsToken(JSONElement<LENGTH>* e, const bool allocated, const int16_t depth, uint16_t& n) {
+        n++;
+#if GJSON_STATS
+        JSONParseStats::TOKEN k = JSONParseStats::TOKEN_ARRAY;
+
+        if (JSONElement<LENGTH>::MAP == e->Type()) {
+            k = JSONParseStats::TOKEN_MAP;
+        }else if (JSONElement<LENGTH>::KEY == e->Type()) {
+            k = JSONParseStats::TOKEN_ATTRIBUTE;
+        }else if (JSONElement<LENGTH>::STRING == e->Type()) {
+            auto s = reinterpret_cast<JSONString<LENGTH>*>(e);
+
+            k = !s->IsValue() ? JSONParseStats::TOKEN_ATTRIBUTE : (s->IsValueLiteral() ? JSONParseStats::TOKEN_LITERAL : JSONParseStats::TOKEN_VALUE);
+        }
+        stats_.tokens[k]++;
+        if (allocated) {
+            stats_.allocations++;
+            stats_.object_bytes += ElementSize(e);
+            if (stats_.object_bytes > stats_.peak_object_bytes) {
+                stats_.peak_object_bytes = stats_.object_bytes;
+            }
+        }
+        if (depth > 0 && static_cast<uint16_t>(depth) > stats_.max_depth) {
+            stats_.max_depth = depth;
+        }
+#endif // GJSON_STATS
+    }
+
+
+    /**
+     * Helper to set source span of string element from parse state, quoted strings including their quotes.  Without 
+     * \ref GJSON_SOURCE_SPANS nothing
+     *
+     * \param[in,out] e Pointer to string or interned attribute/property element
+     * \param[in] st Parse state holding string start and end
+     */
+    static void Source(JSONElement<LENGTH>* e, const JSONParseState& st) {
+#if GJSON_SOURCE_SPANS
+        JSONSpan sp;
+
+        sp.Set(st.str_start, st.str_end - st.str_start, (2 != st.is_literal));
+        e->Source(sp.offset, sp.length);
+#endif // GJSON_SOURCE_SPANS
+    }
+
+
+    /**
+     * Statistics helper, record element release.  Without \ref GJSON_STATS nothing
+     *
+     * \param[in] e Pointer to element
+     */
+    void StatsFree(JSONElement<LENGTH>* e) {
+#if GJSON_STATS
+        uint32_t sz = ElementSize(e);
+
+        stats_.frees++;
+        stats_.object_bytes = (stats_.object_bytes > sz) ? stats_.object_bytes - sz : 0;
+#endif // GJSON_STATS
+    }
+
+
+    /**
+     * Helper to set string value data during string parse, literal as is or quoted with escapes decoded
+     *
+     * \param[in,out] a Pointer to string value element
+     * \param[in] s Pointer to value data, not NULL terminated
+     * \param[in] l Value data length, characters
+     * \param[in] is_literal Flag indicating value data is unquoted literal
+     * \retval true Data accepted
+     * \retval false Data accepted but not literal
+     */
+    static bool ValueData(JSONString<LENGTH>* a, const char* s, const uint16_t l, const bool is_literal) {
+        if (!is_literal) {
+            a->DataEscaped(s, l);
+
+            return true;
+        }
+
+        return a->Data(s, true, l);
+    }
+
+
+    /**
+     * Helper to allocate array element for object chain, from element pool when set else heap
+     *
+     * \param[in] is_open IsOpen boolean, when true indicates array opening (start)
+     * \param[in] e Pointer, parent element or NULL (no parent yet)
+     * \return Element pointer or NULL, last error ERR_OBJECT_MEMORY_LIMIT
+     */
+    JSONArray<LENGTH>* NewArray(const bool is_open, JSONElement<LENGTH>* e) {
+        JSONArray<LENGTH>* a;
+
+        if (pool_) {
+            a = pool_->Array(is_open);
+        }else {
+            a = GJSON_NEW_OBJECT( JSONArray<LENGTH>(is_open), JSONArray<LENGTH> );
+        }
+
+        return Linked(a, e);
+    }
+
+
+    /**
+     * Helper to allocate map element for object chain, from element pool when set else heap
+     *
+     * \param[in] is_open IsOpen boolean, when true indicates map opening (start)
+     * \param[in] e Pointer, parent element or NULL (no parent yet)
+     * \return Element pointer or NULL, last error ERR_OBJECT_MEMORY_LIMIT
+     */
+    JSONMap<LENGTH>* NewMap(const bool is_open, JSONElement<LENGTH>* e) {
+        JSONMap<LENGTH>* m;
+
+        if (pool_) {
+            m = pool_->Map(is_open);
+        }else {
+            m = GJSON_NEW_OBJECT( JSONMap<LENGTH>(is_open), JSONMap<LENGTH> );
+        }
+
+        return Linked(m, e);
+    }
+
+
+    /**
+     * Helper to allocate string element for object chain, from element pool when set else heap
+     *
+     * \param[in] is_value IsValue boolean, when true indicates string is a value
+     * \param[in] e Pointer, parent element or NULL (no parent yet)
+     * \return Element pointer or NULL, last error ERR_OBJECT_MEMORY_LIMIT
+     */
+    JSONString<LENGTH>* NewString(const bool is_value, JSONElement<LENGTH>* e) {
+        JSONString<LENGTH>* a;
+
+        if (pool_) {
+            a = pool_->String(is_value);
+        }else {
+            a = GJSON_NEW_OBJECT( JSONString<LENGTH>(is_value), JSONString<LENGTH> );
+        }
+
+        return Linked(a, e);
+    }
+
+
+    /**
+     * Helper to link new object chain element to parent.  Element is released when it cannot be linked, 
+     * see \ref JSONElement::Next
+     *
+     * \tparam T Element type
+     * \param[in] a Pointer to element or NULL (out of memory)
+     * \param[in] e Pointer, parent element or NULL (no parent)
+     * \return Element pointer or NULL, last error ERR_OBJECT_MEMORY_LIMIT
+     */
+    template<typename T>
+    T* Linked(T* a, JSONElement<LENGTH>* e) {
+        if (a && e && !e->Next(a)) {
+            if (pool_) {
+                pool_->Release(a);
+            }else {
+                JSONNodePool<LENGTH>::Free(a);
+            }
+            a = NULL;
+        }
+        if (!a) {
+            last_error_ = ERR_OBJECT_MEMORY_LIMIT;
+        }
+
+        return a;
+    } // Linked(...)
+
+
+    /**
+     * Helper to take scratch element for string parse when no object chain wanted.  Two of each 
+     * element type alternate so the previous element of same type remains valid
+     *
+     * \tparam T Element type
+     * \param[in,out] slots Pointer to pair of elements
+     * \param[in,out] k Slot index of last element taken
+     * \param[in] v Element value
+     * \return Scratch element pointer
+     */
+    template<typename T>
+    static T* Scratch(T* slots, uint8_t& k, const T& v) {
+        k ^= 1;
+        slots[k] = v;
+
+        return &slots[k];
+    } // Scratch(...)
+
+
+    /**
+     * Helper to get relative nesting depth of string parse in progress.  For use within callbacks
+     *
+     * \return Depth of open arrays and maps since parse start, 0 when not parsing
      */
-    using JSONParse<LENGTH>::GetLastError;
+    int16_t Depth() const {
+        return state_ ? state_->Depth() : 0;
+    }
+
+
+    /**
+     * Helper to set error condition
+     *
+     * \param[in] error Error condition code, \ref ERR
+     */
+    void Error(const ERR error) {
+        last_error_ = error;
+    }
+
+
+protected:
+    ERR         last_error_;                ///< Last error
+    OP          operation_;                 ///< Current operation
+    uint32_t    binary_size_;               ///< Size of binary, Bytes
+    uint32_t    limit_memory_;              ///< Limit of memory, Bytes
+    I*          io_;                        ///< IO instance pointer
+    bool        limit_node_level_;          ///< Limit node level flag
+    bool        callbacks_;                 ///< Callbacks employed flag
+    bool        case_sensitive_;            ///< Case sensitive checks flag
+    bool        validate_utf8_;             ///< Validate UTF-8 strings flag
+    JSONElement<LENGTH>* last_e_;           ///< Last element processed pointer
+    JSONElement<LENGTH>* like_;             ///< Search like element pointer
+    JSONParseState* state_;                 ///< Current string parse state pointer, NULL when not parsing
+    JSONIntern<LENGTH>* intern_;            ///< Attribute/property intern table pointer, NULL none
+    JSONString<LENGTH>* key_;               ///< Interned attribute/property copy pointer (found or parsed), NULL none
+    JSONNodePool<LENGTH>* pool_;            ///< Element pool pointer, NULL heap
+    bool        pack_numbers_;              ///< Pack numeric arrays flag
+    bool        pack_float_;                ///< Pack decimals single precision flag
+#if GJSON_STATS
+    JSONParseStats stats_;                  ///< Statistics
+#endif // GJSON_STATS
+}; // class JSONParse
+
+
+/**
+ * JSON non-recursive string parser by subclass for searching and replacing JSON string attributes/properties in Maps.  Uses user supplied
+ * I/O as source of JSON string.
+ *
+ * \tparam LENGTH Maximum length (including NULL terminator) in characters of a string attribute/property
+ */
+template<uint8_t LENGTH>
+class JSONSimpleStringParseAttr : protected JSONParse<LENGTH, JSONSimpleStringParseAttr<LENGTH> > {
+    typedef JSONParse<LENGTH, JSONSimpleStringParseAttr<LENGTH> > Parse;    ///< Base parser, callbacks bound at compile time
+    friend class JSONParse<LENGTH, JSONSimpleStringParseAttr<LENGTH> >;
+
+public:
+    /**
+     * \copydoc JSONParse::ERR
+     */
+    using Parse::ERR;
+
+
+    /**
+     * \copydoc JSONParse::GetLastError
+     */
+    using Parse::GetLastError;
 
 
     /**
      * \copydoc JSONParse::LimitNodeLevel
      */
-    using JSONParse<LENGTH>::LimitNodeLevel;
+    using Parse::LimitNodeLevel;
 
 
     /**
      * \copydoc JSONParse::Length
      */
-    using JSONParse<LENGTH>::Length;
+    using Parse::Length;
 
     /**
      * Constructor, make stable instance with given I/O instance
      *
      * \param[in,out] io Pointer to I/O instance, source of JSON string for parsing
      */
-    JSONSimpleStringParseAttr(IO* io) : take_next_(false), replace_(false), rename_(false), attr_(NULL), adj_i_(0), attr_length_(0), JSONParse<LENGTH>(io, 0U) {
-        JSONParse<LENGTH>::Callbacks(true);
+    JSONSimpleStringParseAttr(IO* io) : Parse(io, 0U), container_si_(-1), container_depth_(0), attr_(NULL), attr_length_(0), adj_i_(0), \
+                                cursor_(NULL), take_next_(false), replace_(false), rename_(false), containers_(false) {
+        Parse::Callbacks(true);
         value_[0] = '\0';
     }
 
@@ -1289,6 +2838,9 @@ public:
      *
      * \attention Get value string of found attribute/property by \ref GetAttrValue
      *
+     * \note An attribute/property with array or map value is skipped and search continues, 
+     * see \ref FromStringSearchSpan
+     *
      * \note If JSON string part way through then node alignments will not be met, i.e.
      * there maybe more Array or Map closes than opens.  In this situation caller should 
      * disable via \ref LimitNodeLevel
@@ -1311,6 +2863,9 @@ public:
      *
      * \attention Get value string of found attribute/property by \ref GetAttrValue
      *
+     * \note An attribute/property with array or map value is skipped and search continues, 
+     * see \ref FromStringSearchSpan
+     *
      * \note If JSON string part way through then node alignments will not be met, i.e.
      * there maybe more Array or Map closes than opens.  In this situation caller should 
      * disable via \ref LimitNodeLevel
@@ -1321,8 +2876,60 @@ public:
      * \return Last character index parsed
      */
     uint16_t FromStringSearch(const uint16_t psi, char *a, const bool case_sensitive=true) {
-        uint16_t pi;
+        return Search(psi, a, case_sensitive, false);
+    }
+
 
+    /**
+     * Parse given JSON string looking for specific attribute/property, providing the 
+     * value span.  Unlike \ref FromStringSearch an attribute/property with array or map 
+     * value is found, spanning its matching brackets
+     *
+     * \attention Caller should check \ref GetLastError upon completion for any error
+     * condition that may have risen during parse
+     *
+     * \attention Get spans by \ref GetKeySpan and \ref GetValueSpan, value string by 
+     * \ref GetAttrValue (empty for array or map)
+     *
+     * \param[in] a Attribute/property string (NULL terminated), search string
+     * \param[in] case_sensitive Flag indicating search should be case sensitive, default true
+     * \return Last character index parsed
+     */
+    uint16_t FromStringSearchSpan(char *a, const bool case_sensitive=true) {
+        return FromStringSearchSpan(0, a, case_sensitive);
+    }
+
+
+    /**
+     * \copydoc FromStringSearchSpan(char*, const bool)
+     *
+     * \param[in] psi Parse start character >=0 index < \ref Length
+     */
+    uint16_t FromStringSearchSpan(const uint16_t psi, char *a, const bool case_sensitive=true) {
+        return Search(psi, a, case_sensitive, true);
+    }
+
+
+    /**
+     * Parse given JSON string looking for next occurrence of specific attribute/property, 
+     * providing the value.  Nesting state is kept by cursor between invokes so node level 
+     * checks of \ref LimitNodeLevel hold and each character is parsed only once for all matches
+     *
+     * \attention Caller should check \ref GetLastError upon completion for any error
+     * condition that may have risen during parse
+     *
+     * \attention Get value string of found attribute/property by \ref GetAttrValue and 
+     * value span and depth from cursor
+     *
+     * \attention Do not modify I/O between invokes using the same cursor
+     *
+     * \param[in,out] c Pointer to search cursor, reset to start a new search
+     * \param[in] a Attribute/property string (NULL terminated), search string
+     * \param[in] case_sensitive Flag indicating search should be case sensitive, default true
+     * \retval true Found, cursor updated
+     * \retval false Not found or error, see \ref GetLastError
+     */
+    bool FromStringSearchNext(JSONSearchCursor* c, char *a, const bool case_sensitive=true) {
         take_next_ = false;
         attr_ = a;
         attr_length_ = strlen(a);
@@ -1330,19 +2937,26 @@ public:
             attr_length_ = LENGTH-1;
         }
         value_[0]='\0';
-        JSONParse<LENGTH>::CaseSensitive(case_sensitive);
+        Parse::CaseSensitive(case_sensitive);
         rename_ = false;
         replace_ = false;
-
-        pi = JSONParse<LENGTH>::FromString(psi);
-        if (JSONParse<LENGTH>::ERR_NONE == GetLastError()) {
-            JSONParse<LENGTH>::Error(JSONParse<LENGTH>::ERR_NOT_FOUND);
-        }else if (JSONParse<LENGTH>::ERR_CALLBACK_STOP == GetLastError()) {
-            JSONParse<LENGTH>::Error(JSONParse<LENGTH>::ERR_NONE);
+        containers_ = true;
+        container_si_ = -1;
+        key_span_.Clear();
+        value_span_.Clear();
+        cursor_ = c;
+
+        Parse::FromString(const_cast<char*>(Parse::io_->Get()), NULL, c->state.i, &c->state);
+        cursor_ = NULL;
+        if (Parse::ERR_NONE == GetLastError()) {
+            Parse::Error(Parse::ERR_NOT_FOUND);
+        }else if (Parse::ERR_CALLBACK_STOP == GetLastError()) {
+            Parse::Error(Parse::ERR_NONE);
+            return true;
         }
 
-        return pi;
-    }
+        return false;
+    } // FromStringSearchNext(...)
 
 
     /**
@@ -1395,20 +3009,23 @@ public:
         if (l>=LENGTH) {
             l = LENGTH-1;
         }
-        strncpy(value_, v, l);
+        memcpy(value_, v, l);
         value_[l]='\0';
-        JSONParse<LENGTH>::CaseSensitive(case_sensitive);
+        Parse::CaseSensitive(case_sensitive);
         rename_ = false;
         replace_ = true;
+        containers_ = false;
         adj_i_ = 0;
+        container_si_ = -1;
+        key_span_.Clear();
+        value_span_.Clear();
 
-        pi = JSONParse<LENGTH>::FromString(psi);
-        uint32_t err = GetLastError();
+        pi = Parse::FromString(psi);
 
-        if (JSONParse<LENGTH>::ERR_NONE == GetLastError()) {
-            JSONParse<LENGTH>::Error(JSONParse<LENGTH>::ERR_NOT_FOUND);
-        }else if (JSONParse<LENGTH>::ERR_CALLBACK_STOP == GetLastError()) {
-            JSONParse<LENGTH>::Error(JSONParse<LENGTH>::ERR_NONE);
+        if (Parse::ERR_NONE == GetLastError()) {
+            Parse::Error(Parse::ERR_NOT_FOUND);
+        }else if (Parse::ERR_CALLBACK_STOP == GetLastError()) {
+            Parse::Error(Parse::ERR_NONE);
             //pi += adj_i_;
         }
 
@@ -1469,18 +3086,21 @@ public:
         }
         strncpy(value_, ra, l);
         value_[l]='\0';
-        JSONParse<LENGTH>::CaseSensitive(case_sensitive);
+        Parse::CaseSensitive(case_sensitive);
         rename_ = true;
         replace_ = false;
+        containers_ = false;
         adj_i_ = 0;
+        container_si_ = -1;
+        key_span_.Clear();
+        value_span_.Clear();
 
-        pi = JSONParse<LENGTH>::FromString(psi);
-        uint32_t err = GetLastError();
+        pi = Parse::FromString(psi);
 
-        if (JSONParse<LENGTH>::ERR_NONE == GetLastError()) {
-            JSONParse<LENGTH>::Error(JSONParse<LENGTH>::ERR_NOT_FOUND);
-        }else if (JSONParse<LENGTH>::ERR_CALLBACK_STOP == GetLastError()) {
-            JSONParse<LENGTH>::Error(JSONParse<LENGTH>::ERR_NONE);
+        if (Parse::ERR_NONE == GetLastError()) {
+            Parse::Error(Parse::ERR_NOT_FOUND);
+        }else if (Parse::ERR_CALLBACK_STOP == GetLastError()) {
+            Parse::Error(Parse::ERR_NONE);
             pi += adj_i_;
         }
 
@@ -1491,6 +3111,9 @@ public:
     /**
      * Get attribute/property value string
      *
+     * \note Empty when value was an array or map found by \ref FromStringSearchSpan or 
+     * \ref FromStringSearchNext, see \ref GetValueSpan
+     *
      * \return String pointer, NULL terminated
      */
     const char* GetAttrValue() const {
@@ -1498,29 +3121,36 @@ public:
     }
 
 
-    bool TokenArray(const JSONArray<LENGTH>* e, char *s=NULL, uint16_t i=0) {
-        // String parsing?
-        if (JSONParse<LENGTH>::OP_FROM_STRING == JSONParse<LENGTH>::GetLastOperation()) {
-            if (take_next_) {
-                // Shouldn't get here for string properties, likely an array or map was value not a string
-                take_next_ = false;
-            }
-        }
+    /**
+     * Get span of found attribute/property within JSON string, including quotes.  Valid 
+     * until I/O is modified
+     *
+     * \return Span
+     */
+    const JSONSpan& GetKeySpan() const {
+        return key_span_;
+    }
 
-        return false;
+
+    /**
+     * Get span of found attribute/property value within JSON string.  Scalar values are 
+     * not truncated to LENGTH and array or map values span their matching brackets.  Valid 
+     * until I/O is modified
+     *
+     * \return Span
+     */
+    const JSONSpan& GetValueSpan() const {
+        return value_span_;
+    }
+
+
+    bool TokenArray(const JSONArray<LENGTH>* e, char *s=NULL, uint16_t i=0) {
+        return TokenContainer(e, i);
     } // TokenArray(...)
 
 
     bool TokenMap(const JSONArray<LENGTH>* e, char *s=NULL, uint16_t i=0) {
-        // String parsing?
-        if (JSONParse<LENGTH>::OP_FROM_STRING == JSONParse<LENGTH>::GetLastOperation()) {
-            if (take_next_) {
-                // Shouldn't get here for string properties, likely an array or map was value not a string
-                take_next_ = false;
-            }
-        }
-
-        return false;
+        return TokenContainer(e, i);
     } // TokenMap(...)
 
 
@@ -1528,62 +3158,155 @@ public:
         bool found = false;
 
         // String parsing?
-        if (JSONParse<LENGTH>::OP_FROM_STRING == JSONParse<LENGTH>::GetLastOperation()) {
+        if (Parse::OP_FROM_STRING == Parse::GetLastOperation()) {
             if (e->IsValue()) {
                 if (take_next_) {
                     if (replace_ && si!=ei && si<ei) {
                         uint16_t val_length = strlen(value_);
                         // Replace attribute value
-                        uint16_t adj_length = JSONSupport::Replace(s, JSONParse<LENGTH>::io_->GetLength(), JSONParse<LENGTH>::io_->GetLength(true), si, ei, value_, val_length);
+                        uint16_t adj_length = JSONSupport::Replace(s, Parse::io_->GetLength(), Parse::io_->GetLength(true), si, ei, value_, val_length);
                         if (!adj_length) {
-                            JSONParse<LENGTH>::io_->Length(adj_length);
+                            Parse::io_->Length(adj_length);
                         }
                         // Figure out adjust character index i to make sure the ending character is still the same after replace
                         adj_i_ = val_length - e->Length();
                     }else {
                         strcpy(value_, e->Data());    // Take
                     }
+                    value_span_.Set(si, (replace_ && si<ei) ? strlen(value_) : ei - si, !e->IsValueLiteral());
+                    if (cursor_) {
+                        cursor_->si = si;
+                        cursor_->ei = ei;
+                        cursor_->depth = Parse::Depth();
+                    }
                     found = true;
                     take_next_ = false;
                 }
-            }else {
-                if (!take_next_ && attr_length_) {
-                    if (JSONParse<LENGTH>::case_sensitive_) {
-                        if (!GJSON_REPLACE_STRNCMP(e->Data(), attr_, attr_length_)) {
-                            take_next_ = true;
-                        }
-                    }else {
-                        if (!GJSON_REPLACE_STRNCMPI(e->Data(), attr_, attr_length_)) {
-                            take_next_ = true;
-                        }
-                    }
-                    if (rename_ && take_next_ && si!=ei && si<ei) {
-                        uint16_t val_length = strlen(value_);
-                        // Replace attribute name
-                        uint16_t adj_length = JSONSupport::Replace(s, JSONParse<LENGTH>::io_->GetLength(), JSONParse<LENGTH>::io_->GetLength(true), si, ei, value_, val_length);
-                        if (!adj_length) {
-                            JSONParse<LENGTH>::io_->Length(adj_length);
-                        }
-                        // Figure out adjust character index i to make sure the ending character is still the same after replace
-                        adj_i_ = val_length - e->Length();
-                        found = true;
-                        take_next_ = false;
-                    }
+            }else {
+                if (!take_next_ && attr_length_ && -1 == container_si_) {
+                    if (Parse::case_sensitive_) {
+                        if (!GJSON_REPLACE_STRNCMP(e->Data(), attr_, attr_length_)) {
+                            take_next_ = true;
+                        }
+                    }else {
+                        if (!GJSON_REPLACE_STRNCMPI(e->Data(), attr_, attr_length_)) {
+                            take_next_ = true;
+                        }
+                    }
+                    if (take_next_) {
+                        key_span_.Set(si, ei - si, true);
+                    }
+                    if (rename_ && take_next_ && si!=ei && si<ei) {
+                        uint16_t val_length = strlen(value_);
+                        // Replace attribute name
+                        uint16_t adj_length = JSONSupport::Replace(s, Parse::io_->GetLength(), Parse::io_->GetLength(true), si, ei, value_, val_length);
+                        if (!adj_length) {
+                            Parse::io_->Length(adj_length);
+                        }
+                        // Figure out adjust character index i to make sure the ending character is still the same after replace
+                        adj_i_ = val_length - e->Length();
+                        key_span_.Set(si, val_length, true);
+                        found = true;
+                        take_next_ = false;
+                    }
+                }
+            }
+        }
+
+        return found;
+    } // TokenString(...)
+
+protected:
+    /**
+     * Search for attribute/property, see \ref FromStringSearch and \ref FromStringSearchSpan
+     *
+     * \param[in] psi Parse start character >=0 index < \ref Length
+     * \param[in] a Attribute/property string (NULL terminated), search string
+     * \param[in] case_sensitive Flag indicating search should be case sensitive
+     * \param[in] containers Flag indicating array or map values are found, else skipped
+     * \return Last character index parsed
+     */
+    uint16_t Search(const uint16_t psi, char *a, const bool case_sensitive, const bool containers) {
+        uint16_t pi;
+
+        take_next_ = false;
+        attr_ = a;
+        attr_length_ = strlen(a);
+        if (attr_length_>=LENGTH) {
+            attr_length_ = LENGTH-1;
+        }
+        value_[0]='\0';
+        Parse::CaseSensitive(case_sensitive);
+        rename_ = false;
+        replace_ = false;
+        containers_ = containers;
+        container_si_ = -1;
+        key_span_.Clear();
+        value_span_.Clear();
+
+        pi = Parse::FromString(psi);
+        if (Parse::ERR_NONE == GetLastError()) {
+            Parse::Error(Parse::ERR_NOT_FOUND);
+        }else if (Parse::ERR_CALLBACK_STOP == GetLastError()) {
+            Parse::Error(Parse::ERR_NONE);
+        }
+
+        return pi;
+    } // Search(...)
+
+
+    /**
+     * Handle array or map element for both \ref TokenArray and \ref TokenMap.  A searched 
+     * attribute/property with array or map value is skipped, or when taking containers found 
+     * once its matching close is met
+     *
+     * \param[in] e Array or map element pointer
+     * \param[in] i Current parse character index into source JSON string
+     * \retval true Found, stop parsing
+     * \retval false Continue parsing
+     */
+    bool TokenContainer(const JSONArray<LENGTH>* e, uint16_t i) {
+        bool found = false;
+
+        // String parsing?
+        if (Parse::OP_FROM_STRING == Parse::GetLastOperation()) {
+            if (take_next_) {
+                // Value is an array or map, not a string.  Taken whole when asked for, else search continues
+                take_next_ = false;
+                if (containers_ && e->IsOpen()) {
+                    container_si_ = i;
+                    container_depth_ = Parse::Depth();
+                }
+            }else if (-1 != container_si_ && !e->IsOpen() && Parse::Depth() == container_depth_ + 1) {
+                // Matching close, depth not yet decremented
+                value_span_.Set(container_si_, i + 1 - container_si_, false);
+                if (cursor_) {
+                    cursor_->si = container_si_;
+                    cursor_->ei = i + 1;
+                    cursor_->depth = container_depth_;
                 }
+                container_si_ = -1;
+                found = true;
             }
         }
 
         return found;
-    } // TokenString(...)
+    } // TokenContainer(...)
+
 
-protected:
     char        value_[LENGTH];             ///< Value string
+    JSONSpan    key_span_;                  ///< Found attribute/property span
+    JSONSpan    value_span_;                ///< Found value span
+    int16_t     container_si_;              ///< Array or map value start character index, -1 none
+    int16_t     container_depth_;           ///< Array or map value relative nesting depth
     char*       attr_;                      ///< Attibute/Property string pointer
     uint16_t    attr_length_;               ///< Attribute/Property string length, Characters
     int16_t     adj_i_;                     ///< Adjust index i numeric
+    JSONSearchCursor* cursor_;              ///< Search cursor pointer, NULL when not searching by cursor
     bool        take_next_;                 ///< Take next element flag
     bool        replace_;                   ///< Replace flag
     bool        rename_;                    ///< Rename flag
+    bool        containers_;                ///< Take array or map values whole flag
 }; // class JSONSimpleStringParseAttr
 
 
@@ -1594,38 +3317,41 @@ protected:
  * \tparam LENGTH Maximum length (including NULL terminator) in characters of a string attribute/property
  */
 template<uint8_t LENGTH>
-class JSONSimpleStringParse : protected JSONParse<LENGTH> {
+class JSONSimpleStringParse : protected JSONParse<LENGTH, JSONSimpleStringParse<LENGTH> > {
+    typedef JSONParse<LENGTH, JSONSimpleStringParse<LENGTH> > Parse;    ///< Base parser, callbacks bound at compile time
+    friend class JSONParse<LENGTH, JSONSimpleStringParse<LENGTH> >;
+
 public:
     /**
      * \copydoc JSONParse::ERR
      */
-    using JSONParse<LENGTH>::ERR;
+    using Parse::ERR;
 
 
     /**
      * \copydoc JSONParse::GetLastError
      */
-    using JSONParse<LENGTH>::GetLastError;
+    using Parse::GetLastError;
 
 
     /**
      * \copydoc JSONParse::LimitNodeLevel
      */
-    using JSONParse<LENGTH>::LimitNodeLevel;
+    using Parse::LimitNodeLevel;
 
 
     /**
      * \copydoc JSONParse::Length
      */
-    using JSONParse<LENGTH>::Length;
+    using Parse::Length;
 
     /**
      * Constructor, make stable instance with given I/O instance
      *
      * \param[in,out] io Pointer to I/O instance, source of JSON string for parsing
      */
-    JSONSimpleStringParse(IO* io) : replace_(false), str_(NULL), str_length_(0), adj_i_(0), JSONParse<LENGTH>(io, 0U) {
-        JSONParse<LENGTH>::Callbacks(true);
+    JSONSimpleStringParse(IO* io) : Parse(io, 0U), str_(NULL), str_length_(0), adj_i_(0), cursor_(NULL), replace_(false) {
+        Parse::Callbacks(true);
         value_[0] = '\0';
     }
 
@@ -1674,20 +3400,65 @@ public:
         }
         value_[0]='\0';
         replace_ = false;
-        JSONParse<LENGTH>::CaseSensitive(case_sensitive);
+        Parse::CaseSensitive(case_sensitive);
         adj_i_ = 0;
+        span_.Clear();
 
-        pi = JSONParse<LENGTH>::FromString(psi);
-        if (JSONParse<LENGTH>::ERR_NONE == GetLastError()) {
-            JSONParse<LENGTH>::Error(JSONParse<LENGTH>::ERR_NOT_FOUND);
-        }else if (JSONParse<LENGTH>::ERR_CALLBACK_STOP == GetLastError()) {
-            JSONParse<LENGTH>::Error(JSONParse<LENGTH>::ERR_NONE);
+        pi = Parse::FromString(psi);
+        if (Parse::ERR_NONE == GetLastError()) {
+            Parse::Error(Parse::ERR_NOT_FOUND);
+        }else if (Parse::ERR_CALLBACK_STOP == GetLastError()) {
+            Parse::Error(Parse::ERR_NONE);
         }
 
         return pi;
     }
 
 
+    /**
+     * Parse given JSON string looking for next occurrence of specific string.  Nesting state 
+     * is kept by cursor between invokes so node level checks of \ref LimitNodeLevel hold and 
+     * each character is parsed only once for all matches
+     *
+     * \attention Caller should check \ref GetLastError upon completion for any error
+     * condition that may have risen during parse
+     *
+     * \attention Get string span and depth from cursor
+     *
+     * \attention Do not modify I/O between invokes using the same cursor
+     *
+     * \param[in,out] c Pointer to search cursor, reset to start a new search
+     * \param[in] s String (NULL terminated), search string
+     * \param[in] case_sensitive Flag indicating search should be case sensitive, default true
+     * \retval true Found, cursor updated
+     * \retval false Not found or error, see \ref GetLastError
+     */
+    bool FromStringSearchNext(JSONSearchCursor* c, char *s, const bool case_sensitive=true) {
+        str_ = s;
+        str_length_ = strlen(s);
+        if (str_length_>=LENGTH) {
+            str_length_ = LENGTH-1;
+        }
+        value_[0]='\0';
+        replace_ = false;
+        Parse::CaseSensitive(case_sensitive);
+        adj_i_ = 0;
+        span_.Clear();
+        cursor_ = c;
+
+        Parse::FromString(const_cast<char*>(Parse::io_->Get()), NULL, c->state.i, &c->state);
+        cursor_ = NULL;
+        if (Parse::ERR_NONE == GetLastError()) {
+            Parse::Error(Parse::ERR_NOT_FOUND);
+        }else if (Parse::ERR_CALLBACK_STOP == GetLastError()) {
+            Parse::Error(Parse::ERR_NONE);
+            return true;
+        }
+
+        return false;
+    } // FromStringSearchNext(...)
+
+
     /**
      * Parse given JSON string looking for specific string then replace it.  Provides 
      * character index of replacement
@@ -1741,16 +3512,16 @@ public:
         }
         strncpy(value_, rs, l);
         value_[l]='\0';
-        JSONParse<LENGTH>::CaseSensitive(case_sensitive);
+        Parse::CaseSensitive(case_sensitive);
         adj_i_ = 0;
+        span_.Clear();
 
-        pi = JSONParse<LENGTH>::FromString(psi);
-        uint32_t err = GetLastError();
+        pi = Parse::FromString(psi);
 
-        if (JSONParse<LENGTH>::ERR_NONE == GetLastError()) {
-            JSONParse<LENGTH>::Error(JSONParse<LENGTH>::ERR_NOT_FOUND);
-        }else if (JSONParse<LENGTH>::ERR_CALLBACK_STOP == GetLastError()) {
-            JSONParse<LENGTH>::Error(JSONParse<LENGTH>::ERR_NONE);
+        if (Parse::ERR_NONE == GetLastError()) {
+            Parse::Error(Parse::ERR_NOT_FOUND);
+        }else if (Parse::ERR_CALLBACK_STOP == GetLastError()) {
+            Parse::Error(Parse::ERR_NONE);
             //pi += adj_i_;
         }
 
@@ -1758,13 +3529,24 @@ public:
     } // FromStringReplace(...)
 
 
+    /**
+     * Get span of found string within JSON string, including quotes when quoted.  Not 
+     * truncated to LENGTH and valid until I/O is modified
+     *
+     * \return Span
+     */
+    const JSONSpan& GetSpan() const {
+        return span_;
+    }
+
+
     bool TokenString(const JSONString<LENGTH>* e, char *s=NULL, int16_t si=0, int16_t ei=0) {
         bool found = false;
 
         // String parsing?
-        if (JSONParse<LENGTH>::OP_FROM_STRING == JSONParse<LENGTH>::GetLastOperation()) {
+        if (Parse::OP_FROM_STRING == Parse::GetLastOperation()) {
             if (str_length_) {
-                if (JSONParse<LENGTH>::case_sensitive_) {
+                if (Parse::case_sensitive_) {
                     if (!GJSON_REPLACE_STRNCMP(e->Data(), str_, str_length_)) {
                         found = true;
                     }
@@ -1774,12 +3556,18 @@ public:
                     }
                 }
                 if (found) {
+                    span_.Set(si, (replace_ && si!=ei && si<ei) ? strlen(value_) : ei - si, !e->IsValue() || !e->IsValueLiteral());
+                    if (cursor_) {
+                        cursor_->si = si;
+                        cursor_->ei = ei;
+                        cursor_->depth = Parse::Depth();
+                    }
                     // Replace string?
                     if (replace_ && si!=ei && si<ei) {
                         uint16_t val_length = strlen(value_);
-                        uint16_t adj_length = JSONSupport::Replace(s, JSONParse<LENGTH>::io_->GetLength(), JSONParse<LENGTH>::io_->GetLength(true), si, ei, value_, val_length);
+                        uint16_t adj_length = JSONSupport::Replace(s, Parse::io_->GetLength(), Parse::io_->GetLength(true), si, ei, value_, val_length);
                         if (!adj_length) {
-                            JSONParse<LENGTH>::io_->Length(adj_length);
+                            Parse::io_->Length(adj_length);
                         }
                         // Figure out adjust character index i to make sure the ending character is still the same after replace
                         adj_i_ = val_length - e->Length();
@@ -1796,10 +3584,436 @@ protected:
     char*       str_;                       ///< Value string pointer
     uint16_t    str_length_;                ///< Value string length, Characters
     int16_t     adj_i_;                     ///< Adjust flag
+    JSONSpan    span_;                      ///< Found string span
+    JSONSearchCursor* cursor_;              ///< Search cursor pointer, NULL when not searching by cursor
     bool        replace_;                   ///< Replace flag
 }; // class JSONSimpleStringParse
 
 
+/**
+ * JSON non-recursive string parser by subclass dispatching values to handlers registered per path.  Paths are compiled 
+ * into a trie when registered which the parser advances as it tokenises, so a value reaches its handler with its type 
+ * already converted and without attribute/property string compares in user code.  Uses user supplied I/O as source 
+ * of JSON string.
+ *
+ * Path syntax is that of JSON Pointer where a "*" part is any array element, e.g. "/bar/g1" or "/list/&#42;".
+ *
+ * \attention Path strings are referenced not copied, keep them while parser is in use
+ *
+ * \tparam LENGTH Maximum length (including NULL terminator) in characters of a string attribute/property
+ * \tparam NODES Maximum number of trie nodes, one per distinct path part.  Default 16
+ * \tparam DEPTH Maximum array and map nesting level dispatched.  Default 8
+ */
+template<uint8_t LENGTH, uint8_t NODES=16, uint8_t DEPTH=8>
+class JSONDispatchParse : protected JSONParse<LENGTH, JSONDispatchParse<LENGTH, NODES, DEPTH> > {
+    typedef JSONParse<LENGTH, JSONDispatchParse<LENGTH, NODES, DEPTH> > Parse;    ///< Base parser, callbacks bound at compile time
+    friend class JSONParse<LENGTH, JSONDispatchParse<LENGTH, NODES, DEPTH> >;
+
+public:
+    /**
+     * Boolean value handler.  Return true to stop parsing
+     */
+    typedef bool (*BoolHandler)(void* ctx, const bool v);
+
+
+    /**
+     * Integer value handler.  Return true to stop parsing
+     */
+    typedef bool (*IntHandler)(void* ctx, const int32_t v);
+
+
+    /**
+     * Decimal value handler, integers also accepted.  Return true to stop parsing
+     */
+    typedef bool (*DecimalHandler)(void* ctx, const double v);
+
+
+    /**
+     * String value handler, any value type.  Return true to stop parsing
+     */
+    typedef bool (*StringHandler)(void* ctx, const JSONString<LENGTH>* v);
+
+
+    /**
+     * \copydoc JSONParse::ERR
+     */
+    using Parse::ERR;
+
+
+    /**
+     * \copydoc JSONParse::GetLastError
+     */
+    using Parse::GetLastError;
+
+
+    /**
+     * \copydoc JSONParse::LimitNodeLevel
+     */
+    using Parse::LimitNodeLevel;
+
+
+    /**
+     * \copydoc JSONParse::Length
+     */
+    using Parse::Length;
+
+
+    /**
+     * Constructor, make stable instance with given I/O instance
+     *
+     * \param[in,out] io Pointer to I/O instance, source of JSON string for parsing
+     */
+    JSONDispatchParse(IO* io) : Parse(io, 0U), nodes_(1) {
+        Parse::Callbacks(true);
+        Clear();
+    }
+
+
+    /**
+     * Remove all registered handlers
+     */
+    void Clear() {
+        nodes_ = 1;    // Root only
+        node_[0].name = NULL;
+        node_[0].length = 0;
+        node_[0].child = NONE;
+        node_[0].next = NONE;
+        node_[0].kind = HANDLER_NONE;
+    }
+
+
+    /**
+     * Register boolean value handler.  Value must be literal true or false
+     *
+     * \param[in] p Path string (NULL terminated)
+     * \param[in] h Handler
+     * \param[in] ctx User context passed to handler, default NULL
+     * \retval true Registered
+     * \retval false Failure, bad path or out of nodes.  See \ref GetLastError
+     */
+    bool On(const char* p, BoolHandler h, void* ctx=NULL) {
+        uint8_t n = Insert(p);
+
+        if (NONE != n) {
+            node_[n].kind = HANDLER_BOOL;
+            node_[n].handler.b = h;
+            node_[n].ctx = ctx;
+        }
+
+        return (NONE != n);
+    }
+
+
+    /**
+     * Register integer value handler.  Value must be literal integer
+     *
+     * \copydetails On(const char*, BoolHandler, void*)
+     */
+    bool On(const char* p, IntHandler h, void* ctx=NULL) {
+        uint8_t n = Insert(p);
+
+        if (NONE != n) {
+            node_[n].kind = HANDLER_INT;
+            node_[n].handler.i = h;
+            node_[n].ctx = ctx;
+        }
+
+        return (NONE != n);
+    }
+
+
+    /**
+     * Register decimal value handler.  Value must be literal decimal or integer
+     *
+     * \copydetails On(const char*, BoolHandler, void*)
+     */
+    bool On(const char* p, DecimalHandler h, void* ctx=NULL) {
+        uint8_t n = Insert(p);
+
+        if (NONE != n) {
+            node_[n].kind = HANDLER_DECIMAL;
+            node_[n].handler.d = h;
+            node_[n].ctx = ctx;
+        }
+
+        return (NONE != n);
+    }
+
+
+    /**
+     * Register string value handler.  Any value type, quoted or literal
+     *
+     * \copydetails On(const char*, BoolHandler, void*)
+     */
+    bool On(const char* p, StringHandler h, void* ctx=NULL) {
+        uint8_t n = Insert(p);
+
+        if (NONE != n) {
+            node_[n].kind = HANDLER_STRING;
+            node_[n].handler.s = h;
+            node_[n].ctx = ctx;
+        }
+
+        return (NONE != n);
+    }
+
+
+    /**
+     * Parse given JSON string dispatching values to registered handlers.  Values of 
+     * the wrong type for their handler are ignored
+     *
+     * \attention Caller should check \ref GetLastError upon completion for any error
+     * condition that may have risen during parse, ERR_CALLBACK_STOP when a handler stopped parsing
+     *
+     * \param[in] psi Parse start character >=0 index < \ref Length, default 0
+     * \return Last character index parsed
+     */
+    uint16_t FromString(const uint16_t psi=0) {
+        has_key_ = false;
+        key_node_ = NONE;
+
+        return Parse::FromString(psi);
+    }
+
+
+    bool TokenArray(const JSONArray<LENGTH>* e, char *s=NULL, uint16_t i=0) {
+        return TokenContainer(e);
+    } // TokenArray(...)
+
+
+    bool TokenMap(const JSONArray<LENGTH>* e, char *s=NULL, uint16_t i=0) {
+        return TokenContainer(e);
+    } // TokenMap(...)
+
+
+    bool TokenString(const JSONString<LENGTH>* e, char *s=NULL, int16_t si=0, int16_t ei=0) {
+        bool stop = false;
+
+        if (Parse::OP_FROM_STRING == Parse::GetLastOperation()) {
+            if (!e->IsValue()) {
+                key_node_ = Child(Top(), e->Data(), e->Length());
+                has_key_ = true;
+            }else {
+                uint8_t n = ValueNode();
+
+                if (NONE != n) {
+                    stop = Dispatch(node_[n], e);
+                }
+            }
+        }
+
+        return stop;
+    } // TokenString(...)
+
+protected:
+    static const uint8_t NONE = 0xff;       ///< No trie node index
+
+
+    /**
+     * Enum of handler kinds
+     */
+    typedef enum {
+        HANDLER_NONE,                   /// No handler, path part only
+        HANDLER_BOOL,                   /// \ref BoolHandler
+        HANDLER_INT,                    /// \ref IntHandler
+        HANDLER_DECIMAL,                /// \ref DecimalHandler
+        HANDLER_STRING,                 /// \ref StringHandler
+    }HANDLER;
+
+
+    /**
+     * Trie node, one path part with optional handler
+     */
+    typedef struct {
+        const char* name;               ///< Path part pointer into path string
+        void*       ctx;                ///< Handler user context
+        union {
+            BoolHandler b;
+            IntHandler i;
+            DecimalHandler d;
+            StringHandler s;
+        }handler;                       ///< Handler
+        uint8_t     length;             ///< Path part length, characters
+        uint8_t     child;              ///< First child node index or NONE
+        uint8_t     next;               ///< Next sibling node index or NONE
+        uint8_t     kind;               ///< Handler kind, see \ref HANDLER
+    }Node;
+
+
+    /**
+     * Find child trie node by path part
+     *
+     * \param[in] n Parent node index or NONE
+     * \param[in] name Path part, not terminated
+     * \param[in] length Path part length, characters
+     * \return Child node index or NONE
+     */
+    uint8_t Child(const uint8_t n, const char* name, const uint8_t length) const {
+        uint8_t c = (NONE != n) ? node_[n].child : NONE;
+
+        while(NONE != c) {
+            if (node_[c].length == length && !strncmp(node_[c].name, name, length)) {    // Neither terminated at length
+                break;
+            }
+            c = node_[c].next;
+        }
+
+        return c;
+    } // Child(...)
+
+
+    /**
+     * Insert path into trie
+     *
+     * \param[in] p Path string (NULL terminated)
+     * \return Node index of last path part or NONE upon error
+     */
+    uint8_t Insert(const char* p) {
+        uint8_t n = 0;
+
+        Parse::Error(Parse::ERR_NONE);
+        if ('/' != p[0]) {
+            Parse::Error(Parse::ERR_BAD_ATTRIBUTE);
+            return NONE;
+        }
+        while('/' == p[0]) {
+            const char* t = p + 1;
+            uint8_t tl = 0, c;
+
+            while(t[tl] && '/' != t[tl]) {
+                tl++;
+            }
+            if (!tl) {
+                Parse::Error(Parse::ERR_BAD_ATTRIBUTE);
+                return NONE;
+            }
+            c = Child(n, t, tl);
+            if (NONE == c) {
+                if (nodes_ >= NODES) {
+                    Parse::Error(Parse::ERR_OBJECT_MEMORY_LIMIT);
+                    return NONE;
+                }
+                c = nodes_++;
+                node_[c].name = t;
+                node_[c].length = tl;
+                node_[c].child = NONE;
+                node_[c].kind = HANDLER_NONE;
+                node_[c].next = node_[n].child;
+                node_[n].child = c;
+            }
+            n = c;
+            p = t + tl;
+        }
+
+        return n;
+    } // Insert(...)
+
+
+    /**
+     * Get trie node of innermost open array or map
+     *
+     * \return Node index or NONE
+     */
+    uint8_t Top() const {
+        int16_t d = Parse::Depth();
+
+        return (d > 0 && d <= DEPTH) ? level_node_[d - 1] : NONE;
+    } // Top(...)
+
+
+    /**
+     * Get trie node of value about to be processed, by pending attribute/property when 
+     * in a map otherwise any array element
+     *
+     * \return Node index or NONE
+     */
+    uint8_t ValueNode() {
+        uint8_t n;
+
+        if (has_key_) {
+            n = key_node_;
+            has_key_ = false;
+        }else {
+            n = Child(Top(), "*", 1);
+        }
+
+        return n;
+    } // ValueNode(...)
+
+
+    /**
+     * Handle array or map element for both \ref TokenArray and \ref TokenMap
+     *
+     * \param[in] e Array or map element pointer
+     * \return false, continue parsing
+     */
+    bool TokenContainer(const JSONArray<LENGTH>* e) {
+        if (Parse::OP_FROM_STRING == Parse::GetLastOperation()) {
+            if (e->IsOpen()) {
+                int16_t d = Parse::Depth();    // Not yet incremented
+                uint8_t n = d ? ValueNode() : 0;
+
+                if (d >= 0 && d < DEPTH) {
+                    level_node_[d] = n;
+                }
+            }
+            has_key_ = false;
+        }
+
+        return false;
+    } // TokenContainer(...)
+
+
+    /**
+     * Convert value to handler type and invoke handler
+     *
+     * \param[in] n Trie node
+     * \param[in] v Value string element
+     * \retval true Handler wishes parsing stop
+     * \retval false Continue parsing
+     */
+    bool Dispatch(const Node& n, const JSONString<LENGTH>* v) {
+        bool stop = false;
+
+        switch(n.kind) {
+            case HANDLER_BOOL :
+                if (v->IsBoolean()) {
+                    stop = n.handler.b(n.ctx, 't' == v->Data()[0]);
+                }
+            break;
+
+            case HANDLER_INT :
+                if (v->IsValueLiteral() && v->IsInt()) {
+                    stop = n.handler.i(n.ctx, static_cast<int32_t>(atol(v->Data())));
+                }
+            break;
+
+            case HANDLER_DECIMAL :
+                if (v->IsValueLiteral() && (v->IsInt() || v->IsDecimal())) {
+                    stop = n.handler.d(n.ctx, atof(v->Data()));
+                }
+            break;
+
+            case HANDLER_STRING :
+                stop = n.handler.s(n.ctx, v);
+            break;
+
+            default:
+            break;
+        }
+
+        return stop;
+    } // Dispatch(...)
+
+
+    Node        node_[NODES];               ///< Trie nodes, 0 root
+    uint8_t     level_node_[DEPTH];         ///< Trie node of each open array/map
+    uint8_t     nodes_;                     ///< Trie nodes used
+    uint8_t     key_node_;                  ///< Trie node of pending attribute/property
+    bool        has_key_;                   ///< Attribute/property pending flag
+}; // class JSONDispatchParse
+
+
 
 #if !defined(GJSON_NO_EXAMPLES)
 
@@ -1810,31 +4024,34 @@ protected:
  * \tparam LENGTH Maximum length (including NULL terminator) in characters of a string attribute/property
  */
 template<uint8_t LENGTH>
-class JSONExampleStringParse : protected JSONParse<LENGTH> {
+class JSONExampleStringParse : protected JSONParse<LENGTH, JSONExampleStringParse<LENGTH> > {
+    typedef JSONParse<LENGTH, JSONExampleStringParse<LENGTH> > Parse;    ///< Base parser, callbacks bound at compile time
+    friend class JSONParse<LENGTH, JSONExampleStringParse<LENGTH> >;
+
 public:
     /**
      * \copydoc JSONParse::ERR
      */
-    using JSONParse<LENGTH>::ERR;
+    using Parse::ERR;
 
 
     /**
      * \copydoc JSONParse::GetLastError
      */
-    using JSONParse<LENGTH>::GetLastError;
+    using Parse::GetLastError;
 
 
     /**
      * \copydoc JSONParse::LimitNodeLevel
      */
-    using JSONParse<LENGTH>::LimitNodeLevel;
+    using Parse::LimitNodeLevel;
 
 
     /**
      * Default constructor, make stable instance.  Setup NULL I/O, base parser and enable callbacks
      */
-    JSONExampleStringParse() : jio_(), JSONParse<LENGTH>(&jio_, 0U) {
-        JSONParse<LENGTH>::Callbacks(true);
+    JSONExampleStringParse() : jio_(), Parse(&jio_, 0U) {
+        Parse::Callbacks(true);
     }
 
 
@@ -1852,7 +4069,7 @@ public:
      * \return Last character index parsed.  Debug aid upon error conditions
      */
     uint16_t FromString(char *s) {
-        return JSONParse<LENGTH>::FromString(s, NULL);
+        return Parse::FromString(s, NULL);
     }
 
 
@@ -1861,7 +4078,7 @@ public:
      */
     bool TokenArray(const JSONArray<LENGTH>* e, char *s=NULL, uint16_t i=0) {
         // String parsing?
-        if (JSONParse<LENGTH>::OP_FROM_STRING == JSONParse<LENGTH>::GetLastOperation()) {
+        if (Parse::OP_FROM_STRING == Parse::GetLastOperation()) {
             if (e->IsOpen()) {
                 GJSON_PRINTLINE("[");
             }else {
@@ -1878,7 +4095,7 @@ public:
      */
     bool TokenMap(const JSONArray<LENGTH>* e, char *s=NULL, uint16_t i=0) {
         // String parsing?
-        if (JSONParse<LENGTH>::OP_FROM_STRING == JSONParse<LENGTH>::GetLastOperation()) {
+        if (Parse::OP_FROM_STRING == Parse::GetLastOperation()) {
             if (e->IsOpen()) {
                 GJSON_PRINTLINE("{");
             }else {
@@ -1895,7 +4112,7 @@ public:
      */
     bool TokenString(const JSONString<LENGTH>* e, char *s=NULL, int16_t si=0, int16_t ei=0) {
         // String parsing?
-        if (JSONParse<LENGTH>::OP_FROM_STRING == JSONParse<LENGTH>::GetLastOperation()) {
+        if (Parse::OP_FROM_STRING == Parse::GetLastOperation()) {
             if (e->IsValue()) {
                 if (e->IsValueLiteral()) {
                     GJSON_PRINT("LVal(");
@@ -1929,31 +4146,34 @@ protected:
  * \tparam LENGTH Maximum length (including NULL terminator) in characters of a string attribute/property
  */
 template<uint8_t LENGTH>
-class JSONExampleObjectParse : protected JSONParse<LENGTH> {
+class JSONExampleObjectParse : protected JSONParse<LENGTH, JSONExampleObjectParse<LENGTH> > {
+    typedef JSONParse<LENGTH, JSONExampleObjectParse<LENGTH> > Parse;    ///< Base parser, callbacks bound at compile time
+    friend class JSONParse<LENGTH, JSONExampleObjectParse<LENGTH> >;
+
 public:
     /**
      * \copydoc JSONParse::ERR
      */
-    using JSONParse<LENGTH>::ERR;
+    using Parse::ERR;
 
 
     /**
      * \copydoc JSONParse::GetLastError
      */
-    using JSONParse<LENGTH>::GetLastError;
+    using Parse::GetLastError;
 
 
     /**
      * \copydoc JSONParse::LimitNodeLevel
      */
-    using JSONParse<LENGTH>::LimitNodeLevel;
+    using Parse::LimitNodeLevel;
 
 
     /**
      * Default constructor, make stable instance.  Setup NULL I/O, base parser and enable callbacks
      */
-    JSONExampleObjectParse() : jio_(), JSONParse<LENGTH>(&jio_, 0U) {
-        JSONParse<LENGTH>::Callbacks(true);
+    JSONExampleObjectParse() : jio_(), Parse(&jio_, 0U) {
+        Parse::Callbacks(true);
     }
 
 
@@ -1971,7 +4191,7 @@ public:
      * \retval false Failure, check \ref GetLastError
      */
     bool FromObject(JSONElement<LENGTH>* e) {
-        return JSONParse<LENGTH>::FromObject(e);
+        return Parse::FromObject(e);
     }
 
 
@@ -1980,7 +4200,7 @@ public:
      */
     bool TokenArray(const JSONArray<LENGTH>* e, char *s=NULL, uint16_t i=0) {
         // Object parsing?
-        if (JSONParse<LENGTH>::OP_FROM_OBJECT == JSONParse<LENGTH>::GetLastOperation()) {
+        if (Parse::OP_FROM_OBJECT == Parse::GetLastOperation()) {
             if (e->IsOpen()) {
                 GJSON_PRINTLINE("[");
             }else {
@@ -1997,7 +4217,7 @@ public:
      */
     bool TokenMap(const JSONArray<LENGTH>* e, char *s=NULL, uint16_t i=0) {
         // Object parsing?
-        if (JSONParse<LENGTH>::OP_FROM_OBJECT == JSONParse<LENGTH>::GetLastOperation()) {
+        if (Parse::OP_FROM_OBJECT == Parse::GetLastOperation()) {
             if (e->IsOpen()) {
                 GJSON_PRINTLINE("{");
             }else {
@@ -2014,7 +4234,7 @@ public:
      */
     bool TokenString(const JSONString<LENGTH>* e, char *s=NULL, int16_t si=0, int16_t ei=0) {
         // Object parsing?
-        if (JSONParse<LENGTH>::OP_FROM_OBJECT == JSONParse<LENGTH>::GetLastOperation()) {
+        if (Parse::OP_FROM_OBJECT == Parse::GetLastOperation()) {
             if (e->IsValue()) {
                 if (e->IsValueLiteral()) {
                     GJSON_PRINT("LVal(");
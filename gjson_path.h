@@ -0,0 +1,381 @@
+/**
+ * \file
+ * Embedded JSON builder and parser - JSONPath query
+ * PROJECT: GJSON library
+ * TARGET SYSTEM: Arduino, STM32, Atmel AT91SAM, portable
+ */
+
+#ifndef GJSON_PATH_H
+#define GJSON_PATH_H
+
+namespace gjson {
+
+/**
+ * JSONPath subset query over an object chain.  A query is compiled once then evaluated against
+ * an object chain in a single pass, each match being given lazily by \ref Find and \ref FindNext.
+ *
+ * Supported syntax, query must start at root "$":
+ *   .name or ['name']   Child attribute/property of map
+ *   [n]                 Element n of array
+ *   .* or [*]           Any child of map or array
+ *   ..name, ..* or ..[n] Recursive descent, any descendant matching what follows
+ *
+ * e.g. "$.devices[*].id", "$..id", "$.a.b[3]"
+ *
+ * Evaluation keeps for each open array and map a bit set of how many query steps its value has
+ * matched so far, subtrees that can no longer match are skipped without being looked at further.
+ *
+ * \attention Query string is referenced not copied, keep it while query is in use
+ *
+ * \note Names are compared with object chain strings which are limited to LENGTH-1 characters
+ *
+ * \note Packed numbers (\ref JSONNumbers) are one value, their numbers aren't indexed
+ *
+ * \tparam LENGTH Maximum length (including NULL terminator) in characters of a string attribute/property
+ * \tparam STEPS Maximum number of query steps, 15 or less.  Default 8
+ * \tparam DEPTH Maximum array and map nesting level evaluated.  Default 8
+ */
+template<uint8_t LENGTH, uint8_t STEPS=8, uint8_t DEPTH=8>
+class JSONPath : public JSONConstant {
+public:
+    /**
+     * Constructor, make stable instance with optional query
+     *
+     * \param[in] q JSONPath query string (NULL terminated) or NULL, see \ref Compile
+     */
+    JSONPath(const char* q=NULL) : steps_(0), e_(NULL), key_(NULL), match_key_(NULL), level_(0), skip_(0), last_error_(ERR_NONE), 
+                                intern_(NULL), ks_(false) {
+        if (q) {
+            Compile(q);
+        }
+    }
+
+
+    /**
+     * Compile JSONPath query
+     *
+     * \param[in] q JSONPath query string (NULL terminated)
+     * \retval true Success
+     * \retval false Failure, unsupported syntax or too many steps, \ref GetLastError is ERR_BAD_ATTRIBUTE
+     */
+    bool Compile(const char* q) {
+        uint16_t i = 1;
+
+        steps_ = 0;
+        e_ = NULL;
+        last_error_ = ERR_NONE;
+        if ('$' != q[0]) {
+            last_error_ = ERR_BAD_ATTRIBUTE;
+        }
+        while(ERR_NONE == last_error_ && q[i]) {
+            bool recursive = false;
+
+            if (steps_ >= STEPS) {
+                last_error_ = ERR_BAD_ATTRIBUTE;
+                break;
+            }
+            step_[steps_].kind = STEP_ANY;
+            step_[steps_].name = NULL;
+            step_[steps_].length = 0;
+            step_[steps_].index = 0;
+
+            if ('.' == q[i] && '.' == q[i+1]) {
+                recursive = true;
+                i += 2;
+            }else if ('.' == q[i]) {
+                i++;
+            }else if ('[' != q[i]) {
+                last_error_ = ERR_BAD_ATTRIBUTE;
+                break;
+            }
+            step_[steps_].recursive = recursive;
+
+            if ('*' == q[i]) {
+                i++;
+            }else if ('[' == q[i]) {
+                i++;
+                if ('*' == q[i]) {
+                    i++;
+                }else if ('\'' == q[i] || '\"' == q[i]) {
+                    char qc = q[i++];
+
+                    step_[steps_].kind = STEP_NAME;
+                    step_[steps_].name = &q[i];
+                    while(q[i] && qc != q[i]) {
+                        i++;
+                    }
+                    step_[steps_].length = &q[i] - step_[steps_].name;
+                    if (qc != q[i]) {
+                        last_error_ = ERR_BAD_ATTRIBUTE;
+                        break;
+                    }
+                    i++;
+                }else if (q[i]>='0' && q[i]<='9') {
+                    step_[steps_].kind = STEP_INDEX;
+                    while(q[i]>='0' && q[i]<='9') {
+                        step_[steps_].index = (step_[steps_].index * 10) + (q[i++] - '0');
+                    }
+                }else {
+                    last_error_ = ERR_BAD_ATTRIBUTE;
+                    break;
+                }
+                if (']' != q[i]) {
+                    last_error_ = ERR_BAD_ATTRIBUTE;
+                    break;
+                }
+                i++;
+            }else {
+                step_[steps_].kind = STEP_NAME;
+                step_[steps_].name = &q[i];
+                while(q[i] && '.' != q[i] && '[' != q[i]) {
+                    i++;
+                }
+                step_[steps_].length = &q[i] - step_[steps_].name;
+                if (!step_[steps_].length) {
+                    last_error_ = ERR_BAD_ATTRIBUTE;
+                    break;
+                }
+            }
+            steps_++;
+        }
+        if (ERR_NONE != last_error_) {
+            steps_ = 0;
+        }
+
+        return (ERR_NONE == last_error_);
+    } // Compile(...)
+
+
+    /**
+     * Evaluate compiled query against object chain, giving first match
+     *
+     * \attention Caller should check \ref GetLastError when NULL returned.  ERR_NOT_FOUND
+     * means no (further) matches
+     *
+     * \param[in] e Pointer to first JSON element in object chain, the root value
+     * \return Matched value element pointer, string value, packed numbers, raw text or array/map open.  NULL none
+     */
+    JSONElement<LENGTH>* Find(JSONElement<LENGTH>* e) {
+        e_ = (ERR_BAD_ATTRIBUTE == last_error_ && !steps_) ? NULL : e;    // Not compiled
+        key_ = NULL;
+        match_key_ = NULL;
+        level_ = 0;
+        skip_ = 0;
+        if (e_) {
+            last_error_ = ERR_NONE;
+        }
+
+        return FindNext();
+    } // Find(...)
+
+
+    /**
+     * Continue evaluation of compiled query from last match, see \ref Find
+     *
+     * \return Matched value element pointer, string value or array/map open.  NULL none
+     */
+    JSONElement<LENGTH>* FindNext() {
+        JSONElement<LENGTH>* f = NULL;
+
+        while(e_ && !f && ERR_NONE == last_error_) {
+            JSONElement<LENGTH>* e = e_;
+
+            e_ = e->Next();
+            switch(e->Type()) {
+                case JSONElement<LENGTH>::ARRAY :
+                case JSONElement<LENGTH>::MAP : {
+                    auto a = reinterpret_cast<JSONArray<LENGTH>*>(e);
+
+                    if (skip_) {
+                        // Within subtree that cannot match
+                        skip_ += a->IsOpen() ? 1 : -1;
+                    }else if (a->IsOpen()) {
+                        uint16_t m = ValueMask();
+
+                        if (m & (1U << steps_)) {
+                            f = e;
+                            match_key_ = key_;
+                        }
+                        if (!m) {
+                            skip_ = 1;
+                        }else if (level_ >= DEPTH) {
+                            last_error_ = ERR_OBJECT_MEMORY_LIMIT;
+                        }else {
+                            mask_[level_] = m;
+                            index_[level_] = 0;
+                            level_++;
+                        }
+                    }else {
+                        if (!level_) {
+                            last_error_ = (JSONElement<LENGTH>::MAP == e->Type()) ? ERR_UNEXPECTED_END_OF_MAP : ERR_UNEXPECTED_END_OF_ARRAY;
+                        }else {
+                            level_--;
+                        }
+                    }
+                    key_ = NULL;
+                    if (!skip_ && !level_ && !a->IsOpen()) {
+                        e_ = NULL;    // Root value closed
+                    }
+                }
+                break;
+
+                case JSONElement<LENGTH>::KEY : {
+                    if (!skip_) {
+                        // Interned attribute/property, compared as string copy
+                        key_ = (intern_ && intern_->Key(reinterpret_cast<JSONKey<LENGTH>*>(e)->Id(), &ks_)) ? &ks_ : NULL;
+                        if (!key_) {
+                            last_error_ = ERR_BAD_ATTRIBUTE;
+                        }
+                    }
+                }
+                break;
+
+                case JSONElement<LENGTH>::NUMBERS :
+                case JSONElement<LENGTH>::RAW :
+                case JSONElement<LENGTH>::STRING : {
+                    auto s = reinterpret_cast<JSONString<LENGTH>*>(e);
+
+                    if (!skip_) {
+                        if (JSONElement<LENGTH>::STRING == e->Type() && !s->IsValue()) {
+                            key_ = s;
+                        }else {
+                            if (ValueMask() & (1U << steps_)) {
+                                f = e;
+                                match_key_ = key_;
+                            }
+                            key_ = NULL;
+                            if (!level_) {
+                                e_ = NULL;    // Root value was a string
+                            }
+                        }
+                    }
+                }
+                break;
+
+                default:
+                break;
+            } // switch(e->Type())
+        } // while(e_ && ...)
+        if (!f && ERR_NONE == last_error_) {
+            last_error_ = ERR_NOT_FOUND;
+        }
+
+        return f;
+    } // FindNext(...)
+
+
+    /**
+     * Set attribute/property intern table of object chains built by a parser given one, see \ref JSONParse::Intern
+     *
+     * \param[in] intern Pointer to intern table or NULL (none, default)
+     */
+    void Intern(const JSONIntern<LENGTH>* intern) {
+        intern_ = intern;
+    }
+
+
+    /**
+     * Get attribute/property of last match when match was a map member
+     *
+     * \note Interned attribute/property is a copy held by query, valid until next evaluation
+     *
+     * \return String element pointer or NULL, match was array element or root
+     */
+    JSONString<LENGTH>* GetKey() const {
+        return match_key_;
+    }
+
+
+    /**
+     * Get last compile or evaluate error condition (if any).  For list see enum \ref ERR
+     *
+     * \return ERR numeric
+     */
+    ERR GetLastError() const {
+        return last_error_;
+    }
+
+protected:
+    /**
+     * Enum of query step kinds
+     */
+    typedef enum {
+        STEP_ANY,                       /// Any child
+        STEP_NAME,                      /// Child by attribute/property name
+        STEP_INDEX,                     /// Child by array index
+    }STEP;
+
+
+    /**
+     * Compiled query step
+     */
+    typedef struct {
+        const char* name;               ///< Name pointer into query string, STEP_NAME only
+        uint16_t    index;              ///< Array index, STEP_INDEX only
+        uint8_t     length;             ///< Name length, characters
+        uint8_t     kind;               ///< Step kind, see \ref STEP
+        bool        recursive;          ///< Recursive descent flag
+    }Step;
+
+
+    /**
+     * Get steps matched bit set for value about to be processed, bit n meaning first n steps
+     * matched.  Array index of parent advanced
+     *
+     * \return Bit set, 0 value and all its descendants cannot match
+     */
+    uint16_t ValueMask() {
+        uint16_t pm, m = 0, idx = 0;
+        uint8_t k;
+        bool in_map;
+
+        if (!level_) {
+            return 1;    // Root value, no steps matched
+        }
+        pm = mask_[level_ - 1];
+        in_map = (NULL != key_);
+        if (!in_map) {
+            idx = index_[level_ - 1]++;
+        }
+        for(k=0; k<steps_; k++) {
+            if (pm & (1U << k)) {
+                const Step& st = step_[k];
+                bool match = false;
+
+                if (STEP_ANY == st.kind) {
+                    match = true;
+                }else if (STEP_NAME == st.kind) {
+                    match = in_map && key_->Length() == st.length && !GJSON_REPLACE_STRNCMP(key_->Data(), st.name, st.length);
+                }else {
+                    match = !in_map && idx == st.index;
+                }
+                if (match) {
+                    m |= (1U << (k + 1));
+                }
+                if (st.recursive) {
+                    m |= (1U << k);    // Descendants remain candidates
+                }
+            }
+        }
+
+        return m;
+    } // ValueMask(...)
+
+
+    Step        step_[STEPS];               ///< Compiled query steps
+    uint16_t    mask_[DEPTH];               ///< Steps matched bit set of each open array/map
+    uint16_t    index_[DEPTH];              ///< Next element index of each open array/map
+    uint8_t     steps_;                     ///< Number of compiled query steps
+    JSONElement<LENGTH>* e_;                ///< Next element to evaluate pointer
+    JSONString<LENGTH>* key_;               ///< Pending attribute/property pointer
+    JSONString<LENGTH>* match_key_;         ///< Attribute/property of last match pointer
+    uint8_t     level_;                     ///< Open array/map count
+    uint16_t    skip_;                      ///< Skipped subtree nesting count, 0 not skipping
+    ERR         last_error_;                ///< Last error
+    const JSONIntern<LENGTH>* intern_;      ///< Attribute/property intern table pointer, NULL none
+    JSONString<LENGTH> ks_;                 ///< Interned attribute/property copy
+}; // class JSONPath
+
+}; // namespace gjson
+
+#endif // GJSON_PATH_H
@@ -0,0 +1,343 @@
+/**
+ * \file
+ * Embedded JSON builder and parser - JSON Pointer
+ * PROJECT: GJSON library
+ * TARGET SYSTEM: Arduino, STM32, Atmel AT91SAM, portable
+ */
+
+#ifndef GJSON_POINTER_H
+#define GJSON_POINTER_H
+
+namespace gjson {
+
+/**
+ * JSON Pointer (RFC 6901) evaluator working directly on JSON string held by user supplied I/O.  No
+ * objects are created and no callbacks made; only the members and elements along the pointer path
+ * are looked at, other values are skipped by quote and bracket matching without being tokenised.
+ *
+ * Result is a span of the referenced value, see \ref JSONSpan
+ *
+ * \note Attribute/property names are compared character for character with pointer reference
+ * tokens after "~0" and "~1" decode.  JSON string escapes within names are not decoded
+ *
+ * \note Skipped values are not validated, only their quotes and brackets are followed
+ */
+class JSONPointer : public JSONConstant {
+public:
+    /**
+     * Constructor, make stable instance with given I/O instance
+     *
+     * \param[in] io Pointer to I/O instance, source of JSON string
+     */
+    JSONPointer(IO* io) : io_(io), last_error_(ERR_NONE) { }
+
+
+    /**
+     * Evaluate JSON Pointer against JSON string of I/O
+     *
+     * \attention Caller should check \ref GetLastError upon completion for any error
+     * condition that may have risen during evaluation
+     *
+     * \param[in] p JSON Pointer string (NULL terminated), e.g. "/a/b/3/c".  Empty string
+     * references whole JSON string
+     * \retval true Found, see \ref GetSpan
+     * \retval false Not found or error.  ERR_BAD_ATTRIBUTE when pointer does not start with '/' or 
+     * holds '~' other than "~0" or "~1"
+     */
+    bool Find(const char* p) {
+        const char* s = io_->Get();
+        uint16_t l = io_->GetLength();
+        uint16_t i = SkipWhiteSpace(s, 0, l);
+
+        span_.Clear();
+        last_error_ = ERR_NONE;
+        if (p[0] && '/' != p[0]) {
+            last_error_ = ERR_BAD_ATTRIBUTE;    // Pointer must be empty or start with '/'
+            return false;
+        }
+        while(ERR_NONE == last_error_ && '/' == p[0]) {
+            const char* t = p + 1;
+            uint16_t tl = 0;
+
+            // Reference token runs to next '/' or end of pointer, '~' only escapes '0' or '1'
+            while(t[tl] && '/' != t[tl]) {
+                if ('~' == t[tl] && '0' != t[tl + 1] && '1' != t[tl + 1]) {
+                    last_error_ = ERR_BAD_ATTRIBUTE;
+                }
+                tl++;
+            }
+            if (ERR_NONE != last_error_) {
+                break;    // Bad escape
+            }else if (i >= l) {
+                last_error_ = ERR_NOT_FOUND;
+            }else if ('{' == s[i]) {
+                i = FindMember(s, i, l, t, tl);
+            }else if ('[' == s[i]) {
+                i = FindElement(s, i, l, t, tl);
+            }else {
+                last_error_ = ERR_NOT_FOUND;    // Scalar has no children
+            }
+            p = t + tl;
+        }
+
+        if (ERR_NONE == last_error_) {
+            uint16_t ei = SkipValue(s, i, l);
+
+            if (ERR_NONE == last_error_) {
+                span_.offset = i;
+                span_.length = ei - i;
+            }
+        }
+
+        return (ERR_NONE == last_error_);
+    } // Find(...)
+
+
+    /**
+     * Get span of value found by last \ref Find
+     *
+     * \return Span
+     */
+    const JSONSpan& GetSpan() const {
+        return span_;
+    }
+
+
+    /**
+     * Get last evaluate error condition (if any).  For list see enum \ref ERR
+     *
+     * \return ERR numeric
+     */
+    ERR GetLastError() const {
+        return last_error_;
+    }
+
+protected:
+    /**
+     * Skip JSON white space
+     *
+     * \param[in] s JSON string
+     * \param[in] i Character index
+     * \param[in] l JSON string length, characters
+     * \return Character index of first non white space character or l
+     */
+    uint16_t SkipWhiteSpace(const char* s, uint16_t i, const uint16_t l) const {
+        while(i<l && (' ' == s[i] || '\t' == s[i] || '\r' == s[i] || '\n' == s[i])) {
+            i++;
+        }
+
+        return i;
+    } // SkipWhiteSpace(...)
+
+
+    /**
+     * Skip quoted string, escapes honoured
+     *
+     * \param[in] s JSON string
+     * \param[in] i Character index of opening quote
+     * \param[in] l JSON string length, characters
+     * \return Character index after closing quote
+     */
+    uint16_t SkipString(const char* s, uint16_t i, const uint16_t l) {
+        for(i++; i<l; i++) {
+            if ('\\' == s[i]) {
+                i++;
+            }else if ('\"' == s[i]) {
+                return i + 1;
+            }
+        }
+        last_error_ = ERR_UNTERMINATED_STRING;
+
+        return l;
+    } // SkipString(...)
+
+
+    /**
+     * Skip JSON value.  Arrays and maps are skipped by bracket matching alone
+     *
+     * \param[in] s JSON string
+     * \param[in] i Character index of first value character
+     * \param[in] l JSON string length, characters
+     * \return Character index after value
+     */
+    uint16_t SkipValue(const char* s, uint16_t i, const uint16_t l) {
+        if (i>=l) {
+            last_error_ = ERR_BAD_VALUE;
+        }else if ('\"' == s[i]) {
+            i = SkipString(s, i, l);
+        }else if ('{' == s[i] || '[' == s[i]) {
+            char o = s[i];
+            uint16_t depth = 0;
+
+            while(i<l) {
+                char c = s[i];
+
+                if ('\"' == c) {
+                    i = SkipString(s, i, l);
+                    continue;
+                }
+                i++;
+                if ('{' == c || '[' == c) {
+                    depth++;
+                }else if ('}' == c || ']' == c) {
+                    if (!--depth) {
+                        return i;
+                    }
+                }
+            }
+            if (ERR_NONE == last_error_) {
+                last_error_ = ('{' == o) ? ERR_UNEXPECTED_END_OF_MAP : ERR_UNEXPECTED_END_OF_ARRAY;
+            }
+        }else {
+            uint16_t si = i;
+
+            // Literal runs to a separator, close or white space
+            while(i<l && ',' != s[i] && '}' != s[i] && ']' != s[i] && ' ' != s[i] && '\t' != s[i] && '\r' != s[i] && '\n' != s[i]) {
+                i++;
+            }
+            if (si == i) {
+                last_error_ = ERR_BAD_VALUE;
+            }
+        }
+
+        return i;
+    } // SkipValue(...)
+
+
+    /**
+     * Compare attribute/property name with pointer reference token, decoding "~0" as '~' and
+     * "~1" as '/'.  Token escapes are checked by \ref Find
+     *
+     * \param[in] n Name, not terminated
+     * \param[in] nl Name length, characters
+     * \param[in] t Reference token, not terminated
+     * \param[in] tl Reference token length, characters
+     * \retval true Equal
+     * \retval false Differ
+     */
+    bool TokenEquals(const char* n, const uint16_t nl, const char* t, const uint16_t tl) const {
+        uint16_t ni = 0, ti = 0;
+
+        while(ni<nl && ti<tl) {
+            char c = t[ti++];
+
+            if ('~' == c && ti<tl) {
+                c = ('1' == t[ti]) ? '/' : '~';
+                ti++;
+            }
+            if (c != n[ni++]) {
+                return false;
+            }
+        }
+
+        return (ni == nl && ti == tl);
+    } // TokenEquals(...)
+
+
+    /**
+     * Find map member by reference token
+     *
+     * \param[in] s JSON string
+     * \param[in] i Character index of map open
+     * \param[in] l JSON string length, characters
+     * \param[in] t Reference token, not terminated
+     * \param[in] tl Reference token length, characters
+     * \return Character index of member value, only valid without error
+     */
+    uint16_t FindMember(const char* s, uint16_t i, const uint16_t l, const char* t, const uint16_t tl) {
+        i = SkipWhiteSpace(s, i + 1, l);
+        if (i<l && '}' == s[i]) {
+            last_error_ = ERR_NOT_FOUND;    // Empty map
+        }
+        while(ERR_NONE == last_error_) {
+            uint16_t ks, ke;
+
+            if (i>=l || '\"' != s[i]) {
+                last_error_ = ERR_BAD_ATTRIBUTE;
+                break;
+            }
+            ks = i + 1;
+            i = SkipString(s, i, l);
+            ke = i - 1;
+            i = SkipWhiteSpace(s, i, l);
+            if (ERR_NONE != last_error_ || i>=l || ':' != s[i]) {
+                last_error_ = ERR_BAD_ATTRIBUTE;
+                break;
+            }
+            i = SkipWhiteSpace(s, i + 1, l);
+            if (TokenEquals(&s[ks], ke - ks, t, tl)) {
+                break;    // Found, i is value
+            }
+            i = SkipWhiteSpace(s, SkipValue(s, i, l), l);
+            if (ERR_NONE == last_error_) {
+                if (i<l && ',' == s[i]) {
+                    i = SkipWhiteSpace(s, i + 1, l);
+                }else if (i<l && '}' == s[i]) {
+                    last_error_ = ERR_NOT_FOUND;
+                }else {
+                    last_error_ = ERR_UNEXPECTED_END_OF_MAP;
+                }
+            }
+        }
+
+        return i;
+    } // FindMember(...)
+
+
+    /**
+     * Find array element by reference token index
+     *
+     * \param[in] s JSON string
+     * \param[in] i Character index of array open
+     * \param[in] l JSON string length, characters
+     * \param[in] t Reference token, not terminated
+     * \param[in] tl Reference token length, characters
+     * \return Character index of element value, only valid without error
+     */
+    uint16_t FindElement(const char* s, uint16_t i, const uint16_t l, const char* t, const uint16_t tl) {
+        uint16_t ti, n = 0;
+
+        // Index is digits without leading zeros, "-" (past end) can never be found
+        if (!tl || (tl>1 && '0' == t[0])) {
+            last_error_ = ERR_NOT_FOUND;
+            return i;
+        }
+        for(ti=0; ti<tl; ti++) {
+            // Not a digit or index beyond any element a JSON string of 16 bit length may hold
+            if (t[ti]<'0' || t[ti]>'9' || n > (0xffffU - (t[ti] - '0')) / 10) {
+                last_error_ = ERR_NOT_FOUND;
+                return i;
+            }
+            n = (n * 10) + (t[ti] - '0');
+        }
+
+        i = SkipWhiteSpace(s, i + 1, l);
+        if (i<l && ']' == s[i]) {
+            last_error_ = ERR_NOT_FOUND;    // Empty array
+        }
+        while(ERR_NONE == last_error_ && n) {
+            i = SkipWhiteSpace(s, SkipValue(s, i, l), l);
+            if (ERR_NONE == last_error_) {
+                if (i<l && ',' == s[i]) {
+                    i = SkipWhiteSpace(s, i + 1, l);
+                    n--;
+                }else if (i<l && ']' == s[i]) {
+                    last_error_ = ERR_NOT_FOUND;
+                }else {
+                    last_error_ = ERR_UNEXPECTED_END_OF_ARRAY;
+                }
+            }
+        }
+
+        return i;
+    } // FindElement(...)
+
+
+    IO*         io_;                        ///< IO instance pointer
+    ERR         last_error_;                ///< Last error
+    JSONSpan    span_;                      ///< Found value span
+}; // class JSONPointer
+
+}; // namespace gjson
+
+#endif // GJSON_POINTER_H
@@ -0,0 +1,225 @@
+/**
+ * \file
+ * Embedded JSON builder and parser - Element pool
+ * PROJECT: GJSON library
+ * TARGET SYSTEM: Arduino, STM32, Atmel AT91SAM, portable
+ */
+
+#ifndef GJSON_POOL_H
+#define GJSON_POOL_H
+
+namespace gjson {
+
+/**
+ * Element pool, free lists of released array, map and string elements kept for reuse so long lived documents that 
+ * are edited, or JSON strings parsed and released over and over (see \ref JSONParse::Pool), don't keep going to the 
+ * heap.  Free lists are threaded through element next links, elements come from and go back to the heap by 
+ * \ref GJSON_NEW_OBJECT and \ref GJSON_RELEASE_OBJECT when lists are empty or full.
+ *
+ * \attention Only give elements allocated by \ref GJSON_NEW_OBJECT (parser or pool), never stack or builder elements
+ *
+ * \tparam LENGTH Maximum length (including NULL terminator) in characters of a string attribute/property
+ */
+template<uint8_t LENGTH>
+class JSONNodePool {
+public:
+    /**
+     * Constructor, make stable instance with empty free lists
+     *
+     * \param[in] max Maximum elements kept of each type, further released elements go to heap.  Default 0xffff
+     */
+    JSONNodePool(const uint16_t max=0xffff) : max_(max) {
+        for(uint8_t t=0; t<LISTS; t++) {
+            free_[t] = NULL;
+            count_[t] = 0;
+        }
+    }
+
+
+    /**
+     * Destructor, free list elements back to heap
+     */
+    ~JSONNodePool() {
+        Clear();
+    }
+
+
+    /**
+     * Get array element, from free list or heap
+     *
+     * \param[in] is_open IsOpen boolean, when true indicates array opening (start)
+     * \param[in] e Pointer, parent element or NULL (no parent yet)
+     * \return Element pointer or NULL, out of memory or link out of range (see \ref JSONElement::Next)
+     */
+    JSONArray<LENGTH>* Array(const bool is_open, JSONElement<LENGTH>* e=NULL) {
+        return Take(JSONArray<LENGTH>(is_open), ARRAYS, e);
+    }
+
+
+    /**
+     * Get map element, from free list or heap
+     *
+     * \param[in] is_open IsOpen boolean, when true indicates map opening (start)
+     * \param[in] e Pointer, parent element or NULL (no parent yet)
+     * \return Element pointer or NULL, out of memory or link out of range (see \ref JSONElement::Next)
+     */
+    JSONMap<LENGTH>* Map(const bool is_open, JSONElement<LENGTH>* e=NULL) {
+        return Take(JSONMap<LENGTH>(is_open), MAPS, e);
+    }
+
+
+    /**
+     * Get string element, from free list or heap
+     *
+     * \param[in] is_value IsValue boolean, when true indicates string is a value
+     * \param[in] e Pointer, parent element or NULL (no parent yet)
+     * \return Element pointer or NULL, out of memory or link out of range (see \ref JSONElement::Next)
+     */
+    JSONString<LENGTH>* String(const bool is_value, JSONElement<LENGTH>* e=NULL) {
+        return Take(JSONString<LENGTH>(is_value), STRINGS, e);
+    }
+
+
+    /**
+     * Release element to its free list, or heap when list full, element cannot link to list or not array, map or string
+     *
+     * \param[in] e Pointer to element, next link is not followed
+     */
+    void Release(JSONElement<LENGTH>* e) {
+        uint8_t t = List(e);
+
+        if (t < LISTS && count_[t] < max_) {
+            e->Unlink();
+            // Free list head out of link range, see \ref JSONElement::Next
+            if (!free_[t] || e->Next(free_[t])) {
+                free_[t] = e;
+                count_[t]++;
+                return;
+            }
+        }
+        Free(e);
+    } // Release(...)
+
+
+    /**
+     * Release every element of object chain, see \ref Release
+     *
+     * \param[in] h Pointer to pointer of first JSON element in object chain.  This will be NULLed upon completion
+     */
+    void ReleaseChain(JSONElement<LENGTH>** h) {
+        JSONElement<LENGTH>* c = *h;
+
+        while(c) {
+            JSONElement<LENGTH>* n = c->Next();
+
+            Release(c);
+            c = n;
+        }
+        *h = NULL;
+    } // ReleaseChain(...)
+
+
+    /**
+     * Free list elements back to heap
+     */
+    void Clear() {
+        for(uint8_t t=0; t<LISTS; t++) {
+            while(free_[t]) {
+                JSONElement<LENGTH>* n = free_[t]->Next();
+
+                Free(free_[t]);
+                free_[t] = n;
+            }
+            count_[t] = 0;
+        }
+    } // Clear(...)
+
+
+    /**
+     * Get number of elements held by free lists
+     *
+     * \return Elements
+     */
+    uint16_t GetFree() const {
+        return count_[ARRAYS] + count_[MAPS] + count_[STRINGS];
+    }
+
+
+    /**
+     * Free element to heap, by \ref GJSON_RELEASE_OBJECT.  Packed numbers storage by \ref GJSON_RELEASE_ARRAY
+     *
+     * \param[in] e Pointer to element, next link is not followed
+     */
+    static void Free(JSONElement<LENGTH>* e) {
+        if (JSONElement<LENGTH>::NUMBERS == e->Type()) {
+            GJSON_RELEASE_ARRAY( static_cast<uint64_t*>(reinterpret_cast<JSONNumbers<LENGTH>*>(e)->Data()) );
+        }
+        GJSON_RELEASE_OBJECT( e );
+    }
+
+protected:
+    /**
+     * Enum of free lists
+     */
+    typedef enum {
+        ARRAYS = 0,                     ///< Array elements
+        MAPS,                           ///< Map elements
+        STRINGS,                        ///< String elements
+        LISTS,                          ///< Number of lists
+    }LIST;
+
+
+    /**
+     * Get free list of element
+     *
+     * \param[in] e Pointer to element
+     * \return List or LISTS, none
+     */
+    static uint8_t List(JSONElement<LENGTH>* e) {
+        switch(e->Type()) {
+            case JSONElement<LENGTH>::ARRAY : return ARRAYS;
+            case JSONElement<LENGTH>::MAP : return MAPS;
+            case JSONElement<LENGTH>::STRING : return STRINGS;
+            default : return LISTS;
+        }
+    }
+
+
+    /**
+     * Take element from free list reset to given, or heap
+     *
+     * \tparam T Element type
+     * \param[in] o Element to copy, unlinked
+     * \param[in] t Free list
+     * \param[in] e Pointer, parent element or NULL (no parent yet)
+     * \return Element pointer or NULL, out of memory or link out of range (see \ref JSONElement::Next)
+     */
+    template<class T>
+    T* Take(const T& o, const LIST t, JSONElement<LENGTH>* e) {
+        T* a;
+
+        if (free_[t]) {
+            a = static_cast<T*>(free_[t]);
+            free_[t] = free_[t]->Next();
+            count_[t]--;
+            *a = o;
+        }else {
+            a = GJSON_NEW_OBJECT( T(o), T );
+        }
+        if (a && e && !e->Next(a)) {
+            Release(a);    // Out of link range
+            a = NULL;
+        }
+
+        return a;
+    } // Take(...)
+
+
+    JSONElement<LENGTH>* free_[LISTS];      ///< Free list heads
+    uint16_t    count_[LISTS];              ///< Free list elements
+    uint16_t    max_;                       ///< Maximum elements of each free list
+}; // class JSONNodePool
+
+}; // namespace gjson
+
+#endif // GJSON_POOL_H
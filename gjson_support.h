@@ -8,6 +8,10 @@
 #ifndef GJSON_SUPPORT_H
 #define GJSON_SUPPORT_H
 
+#if GJSON_SIMD
+#include <emmintrin.h>
+#endif
+
 namespace gjson {
 
 /**
@@ -110,6 +114,69 @@ public:
     } // IsInt(...)
 
 
+    /**
+     * Convert integer string, as accepted by \ref IsInt, to 64 bit integer without library support
+     *
+     * \param[in] s Pointer, check string need not be null terminated
+     * \param[in] l Length (characters)
+     * \param[out] v Value
+     * \retval true Success
+     * \retval false Failure, not a number or out of range
+     */
+    static bool ToInt(const char *s, const uint16_t l, int64_t& v) {
+        const uint64_t max = static_cast<uint64_t>(-1) >> 1;
+        uint64_t u = 0;
+        uint16_t i = (l>1 && '-' == s[0]) ? 1 : 0;
+
+        if (i>=l) {
+            return false;
+        }
+        for(; i<l; i++) {
+            if (s[i]<'0' || s[i]>'9' || u > max / 10) {
+                return false;
+            }
+            u = u * 10 + (s[i] - '0');
+        }
+        if ('-' == s[0]) {
+            if (u > max + 1) {
+                return false;
+            }
+            v = static_cast<int64_t>(0 - u);
+        }else {
+            if (u > max) {
+                return false;
+            }
+            v = static_cast<int64_t>(u);
+        }
+
+        return true;
+    } // ToInt(...)
+
+
+    /**
+     * Format 64 bit integer as JSON literal without library support
+     *
+     * \param[out] b Destination, at least 21 characters
+     * \param[in] v Value
+     * \return Pointer to NULL terminated string within destination
+     */
+    static char* IntString(char* b, const int64_t v) {
+        uint64_t u = (v < 0) ? 0 - static_cast<uint64_t>(v) : static_cast<uint64_t>(v);
+        uint8_t i = 20;
+
+        b[i] = '\0';
+        do {
+            b[--i] = static_cast<char>('0' + (u % 10));
+            u /= 10;
+        }while(u);
+        if (v < 0) {
+            b[--i] = '-';
+        }
+
+        return &b[i];
+    } // IntString(...)
+
+
     /**
      * Query is string numeric decimal with optional exponent check
      *
@@ -311,7 +378,7 @@ public:
         uint16_t i;
 
         // <s><n>[dp][e<S><n>]
-        //           /|\
+        //            ^
         //            Exponent
         if (JSONSupport::IsDecimal(s, l)) {
             for(i=0; i<l; i++) {
@@ -399,6 +466,405 @@ public:
         return r;
     }
 
+
+    /**
+     * Find length of leading run of string that needs no JSON escape, i.e. no quote, reverse solidus
+     * or control character.  Runs are checked a machine word at a time
+     *
+     * \param[in] s Pointer, string
+     * \param[in] l Length (characters) of string
+     * \return Run length (characters), l when nothing needs escape
+     */
+    static uint16_t EscapeRun(const char* s, const uint16_t l) {
+        uint16_t i = 0;
+
+        for(; (i + sizeof(Word)) <= l; i += sizeof(Word)) {
+            Word w = Load(&s[i]);
+
+            if (HasLess(w, 0x20) || HasByte(w, '\"') || HasByte(w, '\\')) {
+                break;
+            }
+        }
+        while(i<l && '\"' != s[i] && '\\' != s[i] && static_cast<uint8_t>(s[i]) >= 0x20) {
+            i++;
+        }
+
+        return i;
+    } // EscapeRun(...)
+
+
+    /**
+     * Find length of leading run of JSON string that has no escapes.  Runs are checked a machine
+     * word at a time
+     *
+     * \param[in] s Pointer, string
+     * \param[in] l Length (characters) of string
+     * \return Run length (characters), l when no escapes
+     */
+    static uint16_t UnescapeRun(const char* s, const uint16_t l) {
+        uint16_t i = 0;
+
+        for(; (i + sizeof(Word)) <= l; i += sizeof(Word)) {
+            if (HasByte(Load(&s[i]), '\\')) {
+                break;
+            }
+        }
+        while(i<l && '\\' != s[i]) {
+            i++;
+        }
+
+        return i;
+    } // UnescapeRun(...)
+
+
+    /**
+     * Get JSON escape sequence of character needing escape, see \ref EscapeRun
+     *
+     * \param[in] c Character
+     * \param[out] b Pointer, buffer for sequence of at least 7 characters
+     * \return Pointer, null terminated escape sequence in b
+     */
+    static const char* EscapeSequence(const char c, char* b) {
+        const char* hex = "0123456789abcdef";
+
+        b[0] = '\\';
+        b[2] = '\0';
+        switch(c) {
+            case '\"' : b[1] = '\"'; break;
+            case '\\' : b[1] = '\\'; break;
+            case '\b' : b[1] = 'b'; break;
+            case '\f' : b[1] = 'f'; break;
+            case '\n' : b[1] = 'n'; break;
+            case '\r' : b[1] = 'r'; break;
+            case '\t' : b[1] = 't'; break;
+            default:
+                b[1] = 'u';
+                b[2] = '0';
+                b[3] = '0';
+                b[4] = hex[(static_cast<uint8_t>(c) >> 4) & 0xf];
+                b[5] = hex[static_cast<uint8_t>(c) & 0xf];
+                b[6] = '\0';
+            break;
+        }
+
+        return b;
+    } // EscapeSequence(...)
+
+
+    /**
+     * Append null terminated string to I/O with JSON string escapes.  Runs needing no escape are
+     * appended as blocks
+     *
+     * \tparam I I/O type
+     * \param[in,out] io Pointer to I/O instance
+     * \param[in] s Pointer, null terminated string
+     * \retval true Write error
+     * \retval false Success
+     */
+    template<class I>
+    static bool AppendEscaped(I* io, const char* s) {
+        uint16_t i = 0, l = strlen(s);
+        bool wr_err = false;
+
+        while(i<l && !wr_err) {
+            uint16_t r = EscapeRun(&s[i], l - i);
+            char b[8];
+
+            if (r) {
+                wr_err |= io->Append(&s[i], r);
+                i += r;
+            }
+            if (i<l) {
+                wr_err |= io->Append(EscapeSequence(s[i++], b));
+            }
+        }
+
+        return wr_err;
+    } // AppendEscaped(...)
+
+
+    /**
+     * Decode JSON string escapes into destination.  \\uXXXX escapes, including surrogate pairs, are
+     * written as UTF-8; a lone surrogate is written as U+FFFD.  Runs without escapes are block copied
+     *
+     * \note Decode stops when destination is full, a UTF-8 sequence is never split
+     *
+     * \param[out] d Pointer, destination (not null terminated)
+     * \param[in] dl Maximum length (characters) of destination
+     * \param[in] s Pointer, source JSON string without enclosing quotes
+     * \param[in] sl Length (characters) of source
+     * \return Destination length (characters)
+     */
+    static uint16_t Unescape(char* d, const uint16_t dl, const char* s, const uint16_t sl) {
+        uint16_t di = 0, si = 0;
+
+        while(si<sl && di<dl) {
+            uint16_t r = UnescapeRun(&s[si], sl - si);
+            uint32_t cp;
+            uint8_t n;
+
+            if (r > (dl - di)) {
+                r = dl - di;
+            }
+            memcpy(&d[di], &s[si], r);
+            di += r;
+            si += r;
+            if (si>=sl || di>=dl) {
+                break;
+            }
+            if ((si + 1) >= sl) {
+                d[di++] = s[si++];    // Trailing reverse solidus, take as is
+                break;
+            }
+            si++;
+            switch(s[si++]) {
+                case 'b' : cp = '\b'; break;
+                case 'f' : cp = '\f'; break;
+                case 'n' : cp = '\n'; break;
+                case 'r' : cp = '\r'; break;
+                case 't' : cp = '\t'; break;
+                case 'u' :
+                    cp = Hex4(&s[si], sl - si);
+                    if (cp > 0xffff) {
+                        cp = 'u';    // Malformed, take as is
+                        break;
+                    }
+                    si += 4;
+                    if (cp>=0xd800 && cp<=0xdbff) {
+                        uint32_t lo = ((si + 1) < sl && '\\' == s[si] && 'u' == s[si+1]) ? Hex4(&s[si+2], sl - si - 2) : 0x10000;
+
+                        if (lo>=0xdc00 && lo<=0xdfff) {
+                            cp = 0x10000 + ((cp - 0xd800) << 10) + (lo - 0xdc00);
+                            si += 6;
+                        }else {
+                            cp = 0xfffd;
+                        }
+                    }else if (cp>=0xdc00 && cp<=0xdfff) {
+                        cp = 0xfffd;
+                    }
+                break;
+                default: cp = static_cast<uint8_t>(s[si - 1]); break;    // Quote, solidus, reverse solidus or unknown
+            }
+            n = (cp < 0x80) ? 1 : ((cp < 0x800) ? 2 : ((cp < 0x10000) ? 3 : 4));
+            if ((di + n) > dl) {
+                break;
+            }
+            if (1 == n) {
+                d[di++] = static_cast<char>(cp);
+            }else {
+                static const uint8_t lead[] = { 0, 0, 0xc0, 0xe0, 0xf0 };
+                uint8_t k = n;
+
+                while(--k) {
+                    d[di + k] = static_cast<char>(0x80 | (cp & 0x3f));
+                    cp >>= 6;
+                }
+                d[di] = static_cast<char>(lead[n] | cp);
+                di += n;
+            }
+        }
+
+        return di;
+    } // Unescape(...)
+
+
+    /**
+     * Find length of leading run of JSON string content that is plain ASCII, i.e. no quote, reverse
+     * solidus or byte of a UTF-8 sequence.  Runs are checked 16 characters at a time by SSE2 when
+     * \ref GJSON_SIMD otherwise a machine word at a time
+     *
+     * \param[in] s Pointer, string
+     * \param[in] l Length (characters) of string
+     * \return Run length (characters), l when all plain
+     */
+    static uint16_t StringRun(const char* s, const uint16_t l) {
+        uint16_t i = 0;
+
+#if GJSON_SIMD
+        const __m128i q = _mm_set1_epi8('\"'), bs = _mm_set1_epi8('\\');
+
+        for(; (i + 16) <= l; i += 16) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&s[i]));
+            int m = _mm_movemask_epi8(v) | _mm_movemask_epi8(_mm_cmpeq_epi8(v, q)) | _mm_movemask_epi8(_mm_cmpeq_epi8(v, bs));
+
+            if (m) {
+                return i + Ctz(static_cast<uint16_t>(m));
+            }
+        }
+#endif
+        for(; (i + sizeof(Word)) <= l; i += sizeof(Word)) {
+            const Word ones = static_cast<Word>(-1) / 255;
+            Word w = Load(&s[i]);
+
+            if ((w & (ones * 0x80)) || HasByte(w, '\"') || HasByte(w, '\\')) {
+                break;
+            }
+        }
+        while(i<l && '\"' != s[i] && '\\' != s[i] && static_cast<uint8_t>(s[i]) < 0x80) {
+            i++;
+        }
+
+        return i;
+    } // StringRun(...)
+
+
+    /**
+     * UTF-8 validation step, give each byte of string in turn.  Overlong forms, surrogates and code
+     * points above U+10FFFF are rejected
+     *
+     * \param[in,out] st Validation state, 0 at start of string.  Non zero when a sequence is incomplete
+     * \param[in] ch Byte
+     * \retval true Valid so far
+     * \retval false Invalid
+     */
+    static bool UTF8Next(uint8_t& st, const char ch) {
+        static const uint8_t range[][2] = { { 0x80, 0xbf }, { 0xa0, 0xbf }, { 0x80, 0x9f }, { 0x90, 0xbf }, { 0x80, 0x8f } };
+        uint8_t c = static_cast<uint8_t>(ch);
+        uint8_t need = st & 3, sel = st >> 2;
+
+        if (!need) {
+            // Lead byte, low 2 bits continuation bytes needed, upper bits range of first continuation
+            if (c < 0x80) {
+                st = 0;
+            }else if (c>=0xc2 && c<=0xdf) {
+                st = 1;
+            }else if (c>=0xe0 && c<=0xef) {
+                st = 2 | ((0xe0 == c) ? (1 << 2) : ((0xed == c) ? (2 << 2) : 0));
+            }else if (c>=0xf0 && c<=0xf4) {
+                st = 3 | ((0xf0 == c) ? (3 << 2) : ((0xf4 == c) ? (4 << 2) : 0));
+            }else {
+                return false;
+            }
+        }else {
+            if (c < range[sel][0] || c > range[sel][1]) {
+                return false;
+            }
+            st = need - 1;
+        }
+
+        return true;
+    } // UTF8Next(...)
+
+
+    /**
+     * Query is string valid UTF-8
+     *
+     * \param[in] s Pointer, string
+     * \param[in] l Length (characters) of string
+     * \return Boolean
+     */
+    static bool IsUTF8(const char* s, const uint16_t l) {
+        uint16_t i = 0;
+        uint8_t st = 0;
+
+        while(i<l) {
+            if (!st) {
+                i += StringRun(&s[i], l - i);
+                if (i>=l) {
+                    break;
+                }
+            }
+            if (!UTF8Next(st, s[i++])) {
+                return false;
+            }
+        }
+
+        return !st;
+    } // IsUTF8(...)
+
+protected:
+    typedef size_t Word;                    ///< Machine word, unit of run checks
+
+
+    /**
+     * Load machine word from any alignment
+     *
+     * \param[in] s Pointer, characters
+     * \return Word
+     */
+    static Word Load(const char* s) {
+        Word w;
+
+        memcpy(&w, s, sizeof(w));
+
+        return w;
+    }
+
+
+    /**
+     * Query does word contain a byte less than given value
+     *
+     * \param[in] w Word
+     * \param[in] n Value, 128 or less
+     * \return Boolean
+     */
+    static bool HasLess(const Word w, const uint8_t n) {
+        const Word ones = static_cast<Word>(-1) / 255;
+
+        return 0 != ((w - (ones * n)) & ~w & (ones * 0x80));
+    }
+
+
+    /**
+     * Query does word contain given byte
+     *
+     * \param[in] w Word
+     * \param[in] c Byte
+     * \return Boolean
+     */
+    static bool HasByte(const Word w, const char c) {
+        const Word ones = static_cast<Word>(-1) / 255;
+
+        return HasLess(w ^ (ones * static_cast<uint8_t>(c)), 1);
+    }
+
+
+    /**
+     * Count trailing zero bits
+     *
+     * \param[in] m Mask, not 0
+     * \return Bit index of lowest set bit
+     */
+    static uint8_t Ctz(uint16_t m) {
+        uint8_t n = 0;
+
+        while(!(m & 1)) {
+            m >>= 1;
+            n++;
+        }
+
+        return n;
+    }
+
+
+    /**
+     * Convert 4 hex digits
+     *
+     * \param[in] s Pointer, characters
+     * \param[in] l Length (characters) available
+     * \return Value or 0x10000, not 4 hex digits
+     */
+    static uint32_t Hex4(const char* s, const uint16_t l) {
+        uint32_t v = 0;
+
+        if (l < 4) {
+            return 0x10000;
+        }
+        for(uint8_t i=0; i<4; i++) {
+            char c = s[i];
+
+            v <<= 4;
+            if (c>='0' && c<='9') {
+                v |= c - '0';
+            }else if ((c|0x20)>='a' && (c|0x20)<='f') {
+                v |= (c|0x20) - 'a' + 10;
+            }else {
+                return 0x10000;
+            }
+        }
+
+        return v;
+    } // Hex4(...)
 }; // class JSONSupport
 
 }; // namespace gjson
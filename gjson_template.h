@@ -0,0 +1,449 @@
+/**
+ * \file
+ * Embedded JSON builder and parser - Precompiled output template
+ * PROJECT: GJSON library
+ * TARGET SYSTEM: Arduino, STM32, Atmel AT91SAM, portable
+ */
+
+#ifndef GJSON_TEMPLATE_H
+#define GJSON_TEMPLATE_H
+
+namespace gjson {
+
+/**
+ * Precompiled JSON output template.  For JSON of fixed shape where only values change, the template
+ * text is compiled once recording constant fragments and value slots; each render is then a block
+ * append of every fragment with slot values formatted in between.
+ *
+ * Template text is JSON with a placeholder '?' in place of each value, optionally followed by
+ * a fixed width in characters, e.g. {"id":?,"t":?8,"on":?5}.  Fixed width slots are padded with
+ * trailing white space, so all slots of a rendered string may be patched in place by \ref Patch
+ * without moving the rest of the string.
+ *
+ * A template may be made from an object chain by giving placeholders as literal string values,
+ * e.g. JSONString<LENGTH>("?8", true, true), writing the chain with \ref JSONParse::FromObject
+ * then compiling the result.
+ *
+ * \attention Template text is referenced not copied, keep it while template is in use
+ *
+ * \tparam SLOTS Maximum number of value slots.  Default 8
+ */
+template<uint8_t SLOTS=8>
+class JSONTemplate : public JSONConstant {
+public:
+    /**
+     * Constructor, make stable instance with optional template text
+     *
+     * \param[in] t Template text (NULL terminated) or NULL, see \ref Compile
+     * \param[in] places Decimal places of decimal values, trailing zeros removed.  Default 6
+     */
+    JSONTemplate(const char* t=NULL, const uint8_t places=6) : t_(NULL), length_(0), slots_(0), places_(places), last_error_(ERR_NONE) {
+        if (t) {
+            Compile(t);
+        }
+    }
+
+
+    /**
+     * Compile template text.  All slot values are reset to null
+     *
+     * \param[in] t Template text (NULL terminated)
+     * \retval true Success
+     * \retval false Failure, \ref GetLastError is ERR_BAD_ATTRIBUTE for too many slots or a bad width,
+     * ERR_UNTERMINATED_STRING for an unterminated string
+     */
+    bool Compile(const char* t) {
+        uint16_t i, out = 0;
+        bool quoted = false, fixed = true;
+
+        t_ = t;
+        slots_ = 0;
+        last_error_ = ERR_NONE;
+        for(i=0; t[i] && ERR_NONE == last_error_; i++) {
+            if (quoted) {
+                if ('\\' == t[i] && t[i+1]) {
+                    i++;
+                }else if ('\"' == t[i]) {
+                    quoted = false;
+                }
+            }else if ('\"' == t[i]) {
+                quoted = true;
+            }else if ('?' == t[i]) {
+                uint16_t w = 0;
+
+                if (slots_ >= SLOTS) {
+                    last_error_ = ERR_BAD_ATTRIBUTE;
+                    break;
+                }
+                Slot& sl = slot_[slots_];
+                sl.offset = i;
+                sl.length = 1;
+                while(t[i + sl.length]>='0' && t[i + sl.length]<='9' && w <= GJSON_TEMPLATE_WIDTH) {
+                    w = (w * 10) + (t[i + sl.length++] - '0');
+                }
+                if (sl.length > 1 && (!w || w > GJSON_TEMPLATE_WIDTH)) {
+                    last_error_ = ERR_BAD_ATTRIBUTE;
+                    break;
+                }
+                sl.width = static_cast<uint8_t>(w);
+                // Output position is only known while all preceding slots are fixed width
+                sl.out = fixed ? (i + out) : NONE;
+                if (!w) {
+                    fixed = false;
+                }else {
+                    out += w - sl.length;
+                }
+                sl.type = VALUE_NULL;
+                i += sl.length - 1;
+                slots_++;
+            }
+        }
+        if (quoted && ERR_NONE == last_error_) {
+            last_error_ = ERR_UNTERMINATED_STRING;
+        }
+        if (ERR_NONE != last_error_) {
+            t_ = NULL;
+            slots_ = 0;
+        }else {
+            length_ = i;
+        }
+
+        return (ERR_NONE == last_error_);
+    } // Compile(...)
+
+
+    /**
+     * Get number of value slots of compiled template
+     *
+     * \return Slot count
+     */
+    uint8_t Slots() const {
+        return slots_;
+    }
+
+
+    /**
+     * Set slot string value
+     *
+     * \attention String is referenced not copied, keep it until rendered
+     *
+     * \param[in] k Slot index, order of placeholders within template text
+     * \param[in] v String, NULL terminated
+     * \retval true Success
+     * \retval false Failure, no such slot
+     */
+    bool Set(const uint8_t k, const char* v) {
+        if (Select(k)) {
+            slot_[k].type = VALUE_STRING;
+            slot_[k].v.s = v;
+        }
+
+        return (ERR_NONE == last_error_);
+    }
+
+
+    /**
+     * Set slot boolean value
+     *
+     * \param[in] k Slot index, order of placeholders within template text
+     * \param[in] v Value
+     * \retval true Success
+     * \retval false Failure, no such slot
+     */
+    bool Set(const uint8_t k, const bool v) {
+        if (Select(k)) {
+            slot_[k].type = VALUE_BOOL;
+            slot_[k].v.b = v;
+        }
+
+        return (ERR_NONE == last_error_);
+    }
+
+
+    /**
+     * Set slot integer value
+     *
+     * \param[in] k Slot index, order of placeholders within template text
+     * \param[in] v Value
+     * \retval true Success
+     * \retval false Failure, no such slot
+     */
+    bool Set(const uint8_t k, const int v) {
+        return Set(k, static_cast<int64_t>(v), false);
+    }
+
+
+    /**
+     * \copydoc Set(const uint8_t, const int)
+     */
+    bool Set(const uint8_t k, const unsigned int v) {
+        return Set(k, static_cast<int64_t>(v), true);
+    }
+
+
+    /**
+     * \copydoc Set(const uint8_t, const int)
+     */
+    bool Set(const uint8_t k, const long v) {
+        return Set(k, static_cast<int64_t>(v), false);
+    }
+
+
+    /**
+     * \copydoc Set(const uint8_t, const int)
+     */
+    bool Set(const uint8_t k, const unsigned long v) {
+        return Set(k, static_cast<int64_t>(v), true);
+    }
+
+
+    /**
+     * Set slot decimal value
+     *
+     * \param[in] k Slot index, order of placeholders within template text
+     * \param[in] v Value
+     * \retval true Success
+     * \retval false Failure, no such slot
+     */
+    bool Set(const uint8_t k, const double v) {
+        if (Select(k)) {
+            slot_[k].type = VALUE_DECIMAL;
+            slot_[k].v.d = v;
+        }
+
+        return (ERR_NONE == last_error_);
+    }
+
+
+    /**
+     * Set slot to JSON literal null
+     *
+     * \param[in] k Slot index, order of placeholders within template text
+     * \retval true Success
+     * \retval false Failure, no such slot
+     */
+    bool SetNull(const uint8_t k) {
+        if (Select(k)) {
+            slot_[k].type = VALUE_NULL;
+        }
+
+        return (ERR_NONE == last_error_);
+    }
+
+
+    /**
+     * Render template with current slot values into I/O, replacing its content
+     *
+     * \param[in,out] io Pointer to I/O instance, destination of JSON string
+     * \retval true Success
+     * \retval false Failure, check \ref GetLastError.  ERR_BAD_VALUE when value wider than its fixed width slot or decimal NaN, infinite or integer part beyond 32 bits
+     */
+    bool Render(IO* io) {
+        uint16_t i = 0;
+        uint8_t k;
+        bool wr_err = false;
+
+        last_error_ = t_ ? ERR_NONE : ERR_BAD_ATTRIBUTE;
+        io->Length(0);
+        for(k=0; k<slots_ && !wr_err && ERR_NONE == last_error_; k++) {
+            const Slot& sl = slot_[k];
+
+            wr_err |= io->Append(&t_[i], sl.offset - i);
+            if (!sl.width && VALUE_STRING == sl.type) {
+                // Unbounded, straight to I/O
+                wr_err |= io->Append('\"');
+                wr_err |= io->AppendEscaped(sl.v.s);
+                wr_err |= io->Append('\"');
+            }else {
+                char f[GJSON_TEMPLATE_WIDTH + 1];
+                UserBuffer fb(f, sizeof(f));
+
+                if (Format(sl, &fb)) {
+                    wr_err |= io->Append(f, fb.GetLength());
+                    for(uint8_t p=fb.GetLength(); p<sl.width; p++) {
+                        wr_err |= io->Append(' ');
+                    }
+                }
+            }
+            i = sl.offset + sl.length;
+        }
+        if (ERR_NONE == last_error_) {
+            wr_err |= io->Append(&t_[i], length_ - i);
+            io->Append('\0');    // Ignore write error
+            if (wr_err) {
+                last_error_ = ERR_CHAR_MEMORY_LIMIT;
+            }
+        }
+
+        return (ERR_NONE == last_error_);
+    } // Render(...)
+
+
+    /**
+     * Patch current slot values in place into JSON string previously written by \ref Render.  Only
+     * the slot characters are written, all slots must be fixed width
+     *
+     * \param[in,out] io Pointer to I/O instance holding rendered JSON string
+     * \retval true Success
+     * \retval false Failure, check \ref GetLastError.  ERR_BAD_VALUE when a slot is not fixed width
+     * or a value wider than its slot (or decimal out of range)
+     */
+    bool Patch(IO* io) {
+        uint8_t k, i;
+        bool wr_err = false;
+
+        last_error_ = t_ ? ERR_NONE : ERR_BAD_ATTRIBUTE;
+        for(k=0; k<slots_ && !wr_err && ERR_NONE == last_error_; k++) {
+            const Slot& sl = slot_[k];
+            char f[GJSON_TEMPLATE_WIDTH + 1];
+            UserBuffer fb(f, sizeof(f));
+
+            if (!sl.width || NONE == sl.out) {
+                last_error_ = ERR_BAD_VALUE;
+            }else if ((sl.out + sl.width) > io->GetLength()) {
+                last_error_ = ERR_CHAR_MEMORY_LIMIT;
+            }else if (Format(sl, &fb)) {
+                for(i=0; i<sl.width; i++) {
+                    wr_err |= io->Put(sl.out + i, (i < fb.GetLength()) ? f[i] : ' ');
+                }
+            }
+        }
+        if (wr_err) {
+            last_error_ = ERR_CHAR_MEMORY_LIMIT;
+        }
+
+        return (ERR_NONE == last_error_);
+    } // Patch(...)
+
+
+    /**
+     * Get last compile or render error condition (if any).  For list see enum \ref ERR
+     *
+     * \return ERR numeric
+     */
+    ERR GetLastError() const {
+        return last_error_;
+    }
+
+protected:
+    static const uint16_t NONE = 0xffff;    ///< No output position
+
+
+    /**
+     * Enum of slot value types
+     */
+    typedef enum {
+        VALUE_NULL,                     /// JSON literal null, slot not set
+        VALUE_BOOL,                     /// Boolean
+        VALUE_INT,                      /// Signed integer
+        VALUE_UINT,                     /// Unsigned integer
+        VALUE_DECIMAL,                  /// Decimal
+        VALUE_STRING,                   /// String pointer
+    }VALUE;
+
+
+    /**
+     * Compiled value slot
+     */
+    typedef struct {
+        uint16_t    offset;             ///< Placeholder template text index
+        uint16_t    out;                ///< Rendered string index or NONE, not fixed
+        uint8_t     length;             ///< Placeholder length, characters
+        uint8_t     width;              ///< Fixed width, characters.  0 variable
+        uint8_t     type;               ///< Value type, see \ref VALUE
+        union {
+            bool        b;              ///< Boolean value
+            int64_t     i;              ///< Integer value
+            double      d;              ///< Decimal value
+            const char* s;              ///< String value pointer
+        }v;
+    }Slot;
+
+
+    /**
+     * Check slot index, setting error if none
+     *
+     * \param[in] k Slot index
+     * \retval true Slot exists
+     * \retval false No such slot, \ref GetLastError is ERR_NOT_FOUND
+     */
+    bool Select(const uint8_t k) {
+        last_error_ = (k < slots_) ? ERR_NONE : ERR_NOT_FOUND;
+
+        return (ERR_NONE == last_error_);
+    }
+
+
+    /**
+     * Set slot integer value
+     *
+     * \param[in] k Slot index
+     * \param[in] v Value
+     * \param[in] is_unsigned Flag indicating value bits are unsigned
+     * \retval true Success
+     * \retval false Failure, no such slot
+     */
+    bool Set(const uint8_t k, const int64_t v, const bool is_unsigned) {
+        if (Select(k)) {
+            slot_[k].type = is_unsigned ? VALUE_UINT : VALUE_INT;
+            slot_[k].v.i = v;
+        }
+
+        return (ERR_NONE == last_error_);
+    }
+
+
+    /**
+     * Format slot value into buffer, bounded by slot width when fixed
+     *
+     * \param[in] sl Slot
+     * \param[in,out] b Buffer I/O, GJSON_TEMPLATE_WIDTH characters
+     * \retval true Success
+     * \retval false Failure, \ref GetLastError is ERR_BAD_VALUE
+     */
+    bool Format(const Slot& sl, IO* b) {
+        bool wr_err = false;
+
+        switch(sl.type) {
+            case VALUE_BOOL :
+                wr_err |= b->Append(sl.v.b ? "true" : "false");
+            break;
+
+            case VALUE_INT :
+            case VALUE_UINT :
+                wr_err |= JSONWriter::AppendInt(b, sl.v.i, (VALUE_UINT == sl.type));
+            break;
+
+            case VALUE_DECIMAL :
+                wr_err |= JSONWriter::AppendDecimal(b, sl.v.d, places_);
+            break;
+
+            case VALUE_STRING :
+                wr_err |= b->Append('\"');
+                wr_err |= b->AppendEscaped(sl.v.s);
+                wr_err |= b->Append('\"');
+            break;
+
+            default:
+                wr_err |= b->Append("null");
+            break;
+        }
+        if (wr_err || (sl.width && b->GetLength() > sl.width)) {
+            last_error_ = ERR_BAD_VALUE;
+        }
+
+        return (ERR_NONE == last_error_);
+    } // Format(...)
+
+
+    Slot        slot_[SLOTS];               ///< Compiled value slots
+    const char* t_;                         ///< Template text pointer
+    uint16_t    length_;                    ///< Template text length, characters
+    uint8_t     slots_;                     ///< Number of compiled value slots
+    uint8_t     places_;                    ///< Decimal places
+    ERR         last_error_;                ///< Last error
+}; // class JSONTemplate
+
+}; // namespace gjson
+
+#endif // GJSON_TEMPLATE_H
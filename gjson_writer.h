@@ -0,0 +1,525 @@
+/**
+ * \file
+ * Embedded JSON builder and parser - Streaming writer
+ * PROJECT: GJSON library
+ * TARGET SYSTEM: Arduino, STM32, Atmel AT91SAM, portable
+ */
+
+#ifndef GJSON_WRITER_H
+#define GJSON_WRITER_H
+
+namespace gjson {
+
+/**
+ * JSON streaming writer.  Writes JSON straight to user supplied I/O as maps, arrays, keys and values are given
+ * without creating any objects; commas and colons are placed from a bit set recording map or array at each nesting
+ * level.
+ *
+ * e.g. BeginMap(), Key("id"), Value(12), Key("list"), BeginArray(), Value(true), EndArray(), EndMap()
+ * writes {"id":12,"list":[true]}
+ *
+ * Once an error has risen further writes are ignored until \ref Reset
+ *
+ * \note Output is NULL terminated once the outer value is complete, as \ref JSONParse::FromObject
+ */
+class JSONWriter : public JSONConstant {
+public:
+    /**
+     * Constructor, make stable instance with given I/O instance
+     *
+     * \param[in,out] io Pointer to I/O instance, destination of JSON string
+     * \param[in] places Decimal places of decimal values, trailing zeros removed.  Default 6
+     */
+    JSONWriter(IO* io, const uint8_t places=6) : io_(io), places_(places) {
+        Reset();
+    }
+
+
+    /**
+     * Reset writer and empty I/O ready for new JSON string
+     */
+    void Reset() {
+        io_->Length(0);
+        map_ = 0;
+        level_ = 0;
+        first_ = true;
+        key_ = false;
+        last_error_ = ERR_NONE;
+    }
+
+
+    /**
+     * Write map open
+     *
+     * \retval true Success
+     * \retval false Failure, check \ref GetLastError
+     */
+    bool BeginMap() {
+        return Open('{', true);
+    }
+
+
+    /**
+     * Write map close
+     *
+     * \retval true Success
+     * \retval false Failure, check \ref GetLastError
+     */
+    bool EndMap() {
+        return Close('}', true);
+    }
+
+
+    /**
+     * Write array open
+     *
+     * \retval true Success
+     * \retval false Failure, check \ref GetLastError
+     */
+    bool BeginArray() {
+        return Open('[', false);
+    }
+
+
+    /**
+     * Write array close
+     *
+     * \retval true Success
+     * \retval false Failure, check \ref GetLastError
+     */
+    bool EndArray() {
+        return Close(']', false);
+    }
+
+
+    /**
+     * Write map attribute/property, next write is its value
+     *
+     * \param[in] k Attribute/property string, NULL terminated
+     * \retval true Success
+     * \retval false Failure, check \ref GetLastError.  ERR_BAD_ATTRIBUTE when not in map or value expected
+     */
+    bool Key(const char* k) {
+        if (ERR_NONE == last_error_) {
+            if (!level_ || !(map_ & Bit()) || key_) {
+                last_error_ = ERR_BAD_ATTRIBUTE;
+            }else {
+                bool wr_err = false;
+
+                if (!first_) {
+                    wr_err |= io_->Append(',');
+                }
+                wr_err |= AppendString(k);
+                wr_err |= io_->Append(':');
+                key_ = true;
+                Written(wr_err);
+            }
+        }
+
+        return (ERR_NONE == last_error_);
+    } // Key(...)
+
+
+    /**
+     * Write string value
+     *
+     * \param[in] v String, NULL terminated
+     * \retval true Success
+     * \retval false Failure, check \ref GetLastError
+     */
+    bool Value(const char* v) {
+        if (Prefix()) {
+            Complete(AppendString(v));
+        }
+
+        return (ERR_NONE == last_error_);
+    }
+
+
+    /**
+     * Write boolean value
+     *
+     * \param[in] v Value
+     * \retval true Success
+     * \retval false Failure, check \ref GetLastError
+     */
+    bool Value(const bool v) {
+        if (Prefix()) {
+            Complete(io_->Append(v ? "true" : "false"));
+        }
+
+        return (ERR_NONE == last_error_);
+    }
+
+
+    /**
+     * Write integer value
+     *
+     * \param[in] v Value
+     * \retval true Success
+     * \retval false Failure, check \ref GetLastError
+     */
+    bool Value(const int v) {
+        return Value(static_cast<int64_t>(v), false);
+    }
+
+
+    /**
+     * \copydoc Value(const int)
+     */
+    bool Value(const unsigned int v) {
+        return Value(static_cast<int64_t>(v), true);
+    }
+
+
+    /**
+     * \copydoc Value(const int)
+     */
+    bool Value(const long v) {
+        return Value(static_cast<int64_t>(v), false);
+    }
+
+
+    /**
+     * \copydoc Value(const int)
+     */
+    bool Value(const unsigned long v) {
+        return Value(static_cast<int64_t>(v), true);
+    }
+
+
+    /**
+     * \copydoc Value(const int)
+     */
+    bool Value(const long long v) {
+        return Value(static_cast<int64_t>(v), false);
+    }
+
+
+    /**
+     * \copydoc Value(const int)
+     */
+    bool Value(const unsigned long long v) {
+        return Value(static_cast<int64_t>(v), true);
+    }
+
+
+    /**
+     * Write decimal value with decimal places given at construction
+     *
+     * \param[in] v Value
+     * \retval true Success
+     * \retval false Failure, check \ref GetLastError.  ERR_BAD_VALUE when NaN, infinite or integer part beyond 32 bits
+     */
+    bool Value(const double v) {
+        if (!IsDecimalRange(v, places_)) {
+            if (ERR_NONE == last_error_) {
+                last_error_ = ERR_BAD_VALUE;
+            }
+        }else if (Prefix()) {
+            Complete(AppendDecimal(io_, v, places_));
+        }
+
+        return (ERR_NONE == last_error_);
+    }
+
+
+    /**
+     * Write JSON literal null value
+     *
+     * \retval true Success
+     * \retval false Failure, check \ref GetLastError
+     */
+    bool Null() {
+        if (Prefix()) {
+            Complete(io_->Append("null"));
+        }
+
+        return (ERR_NONE == last_error_);
+    }
+
+
+    /**
+     * Get current nesting level
+     *
+     * \return Open maps and arrays
+     */
+    uint8_t Depth() const {
+        return level_;
+    }
+
+
+    /**
+     * Get last write error condition (if any).  For list see enum \ref ERR
+     *
+     * \return ERR numeric
+     */
+    ERR GetLastError() const {
+        return last_error_;
+    }
+
+
+    /**
+     * Append integer to I/O as JSON literal, no printf support required
+     *
+     * \param[in,out] io Pointer to I/O instance
+     * \param[in] n Value
+     * \param[in] is_unsigned Flag indicating value bits are unsigned
+     * \retval true Write error
+     * \retval false Success
+     */
+    static bool AppendInt(IO* io, const int64_t n, const bool is_unsigned) {
+        char b[22];
+        uint8_t i = sizeof(b) - 1;
+        uint64_t u = (is_unsigned || n >= 0) ? static_cast<uint64_t>(n) : static_cast<uint64_t>(-(n + 1)) + 1;
+
+        b[i] = '\0';
+        do {
+            b[--i] = static_cast<char>('0' + (u % 10));
+            u /= 10;
+        }while(u);
+        if (!is_unsigned && n < 0) {
+            b[--i] = '-';
+        }
+
+        return io->Append(&b[i]);
+    } // AppendInt(...)
+
+
+    /**
+     * Check decimal may be written by \ref AppendDecimal, integer part after rounding within 32 bits
+     *
+     * \param[in] d Value
+     * \param[in] places Decimal places
+     * \retval true In range
+     * \retval false NaN, infinite or out of range
+     */
+    static bool IsDecimalRange(const double d, const uint8_t places) {
+        double m = (d < 0) ? -d : d;
+
+        m += Rounding(places);
+
+        return (m < 4294967296.0);    // NaN compares false
+    }
+
+
+    /**
+     * Append decimal to I/O as JSON literal with fixed decimal places, trailing zeros removed.
+     * No printf floating point support required, integer part limited to 32 bits
+     *
+     * \param[in,out] io Pointer to I/O instance
+     * \param[in] d Value
+     * \param[in] places Decimal places, at most 11
+     * \retval true Write error or value out of range, see \ref IsDecimalRange.  Nothing written when out of range
+     * \retval false Success
+     */
+    static bool AppendDecimal(IO* io, double d, const uint8_t places) {
+        char b[12];
+        uint8_t i, l = (places < sizeof(b)) ? places : sizeof(b) - 1;
+        uint32_t ip;
+        bool wr_err = false;
+
+        if (!IsDecimalRange(d, places)) {
+            return true;
+        }
+        if (d < 0) {
+            wr_err |= io->Append('-');
+            d = -d;
+        }
+        d += Rounding(places);
+        ip = static_cast<uint32_t>(d);
+        d -= ip;
+        wr_err |= AppendInt(io, ip, true);
+        for(i=0; i<l; i++) {
+            d *= 10;
+            b[i] = static_cast<char>('0' + static_cast<uint8_t>(d));
+            d -= static_cast<uint8_t>(d);
+        }
+        while(l && '0' == b[l-1]) {
+            l--;
+        }
+        if (l) {
+            b[l] = '\0';
+            wr_err |= io->Append('.');
+            wr_err |= io->Append(b);
+        }
+
+        return wr_err;
+    } // AppendDecimal(...)
+
+protected:
+    /**
+     * Get rounding of last decimal place
+     *
+     * \param[in] places Decimal places, at most 11
+     * \return Half of last place
+     */
+    static double Rounding(const uint8_t places) {
+        double r = 0.5;
+
+        for(uint8_t i=0; i<places && i<11; i++) {
+            r /= 10;
+        }
+
+        return r;
+    }
+
+
+    /**
+     * Get bit of current nesting level within map/array bit set
+     *
+     * \return Bit mask
+     */
+    uint32_t Bit() const {
+        return 1UL << (level_ - 1);
+    }
+
+
+    /**
+     * Write integer value
+     *
+     * \param[in] v Value
+     * \param[in] is_unsigned Flag indicating value bits are unsigned
+     * \retval true Success
+     * \retval false Failure, check \ref GetLastError
+     */
+    bool Value(const int64_t v, const bool is_unsigned) {
+        if (Prefix()) {
+            Complete(AppendInt(io_, v, is_unsigned));
+        }
+
+        return (ERR_NONE == last_error_);
+    }
+
+
+    /**
+     * Append quoted string, JSON string escapes added
+     *
+     * \param[in] s String, NULL terminated
+     * \retval true Write error
+     * \retval false Success
+     */
+    bool AppendString(const char* s) {
+        bool wr_err = false;
+
+        wr_err |= io_->Append('\"');
+        wr_err |= io_->AppendEscaped(s);
+        wr_err |= io_->Append('\"');
+
+        return wr_err;
+    }
+
+
+    /**
+     * Check a value may be written here and write separating comma if required
+     *
+     * \retval true Value may be written
+     * \retval false Failure, check \ref GetLastError.  ERR_BAD_VALUE when map value without attribute/property
+     */
+    bool Prefix() {
+        if (ERR_NONE == last_error_) {
+            if (level_ && (map_ & Bit())) {
+                if (!key_) {
+                    last_error_ = ERR_BAD_VALUE;
+                }
+            }else if (!level_ && !first_) {
+                last_error_ = ERR_UNEXPECTED_DATA;    // Outer value already complete
+            }else if (!first_) {
+                Written(io_->Append(','));
+            }
+        }
+
+        return (ERR_NONE == last_error_);
+    } // Prefix(...)
+
+
+    /**
+     * Record a write took place
+     *
+     * \param[in] wr_err Write error flag
+     */
+    void Written(const bool wr_err) {
+        if (wr_err) {
+            last_error_ = ERR_CHAR_MEMORY_LIMIT;
+        }
+    }
+
+
+    /**
+     * Record a value (or close) was written, terminating output when outer value complete
+     *
+     * \param[in] wr_err Write error flag
+     */
+    void Complete(const bool wr_err) {
+        Written(wr_err);
+        first_ = false;
+        key_ = false;
+        if (!level_) {
+            io_->Append('\0');    // Ignore write error
+        }
+    }
+
+
+    /**
+     * Write map or array open
+     *
+     * \param[in] c Open character
+     * \param[in] is_map Flag indicating map
+     * \retval true Success
+     * \retval false Failure, check \ref GetLastError
+     */
+    bool Open(const char c, const bool is_map) {
+        if (Prefix()) {
+            if (level_ >= 32) {
+                last_error_ = ERR_OBJECT_MEMORY_LIMIT;
+            }else {
+                Written(io_->Append(c));
+                level_++;
+                if (is_map) {
+                    map_ |= Bit();
+                }else {
+                    map_ &= ~Bit();
+                }
+                first_ = true;
+                key_ = false;
+            }
+        }
+
+        return (ERR_NONE == last_error_);
+    } // Open(...)
+
+
+    /**
+     * Write map or array close
+     *
+     * \param[in] c Close character
+     * \param[in] is_map Flag indicating map
+     * \retval true Success
+     * \retval false Failure, check \ref GetLastError
+     */
+    bool Close(const char c, const bool is_map) {
+        if (ERR_NONE == last_error_) {
+            if (!level_ || is_map != ((map_ & Bit()) ? true : false) || key_) {
+                last_error_ = is_map ? ERR_UNEXPECTED_END_OF_MAP : ERR_UNEXPECTED_END_OF_ARRAY;
+            }else {
+                level_--;
+                Complete(io_->Append(c));
+            }
+        }
+
+        return (ERR_NONE == last_error_);
+    } // Close(...)
+
+
+    IO*         io_;                        ///< IO instance pointer
+    uint32_t    map_;                       ///< Bit set, map (1) or array (0) of each nesting level
+    uint8_t     level_;                     ///< Nesting level
+    uint8_t     places_;                    ///< Decimal places
+    bool        first_;                     ///< First value of current level flag
+    bool        key_;                       ///< Attribute/property written, value expected flag
+    ERR         last_error_;                ///< Last error
+}; // class JSONWriter
+
+}; // namespace gjson
+
+#endif // GJSON_WRITER_H
@@ -2,8 +2,14 @@
 //
 #include "stdafx.h"
 
-#define GJSON_NEW_OBJECT(o,t)               (new o); printf("n\n");
-#define GJSON_RELEASE_OBJECT(o)             (delete o); printf("d\n");
+#define GJSON_NEW_OBJECT(o,t)               (printf("n\n"), new o)
+#define GJSON_RELEASE_OBJECT(o)             (printf("d\n"), delete o)
+#define GJSON_STATS                         1
+#define GJSON_SOURCE_SPANS                  1
+
+uint32_t trace_ops = 0, trace_count = 0;
+#define GJSON_TRACE_BEGIN(op, size)         (trace_ops++)
+#define GJSON_TRACE_END(op, size, count)    (trace_count = (count))
 
 #include "../gjson.h"
 
@@ -2602,5 +2608,1132 @@ int _tmain(int argc, _TCHAR* argv[])
         std::cout << "Test passed" << std::endl << std::endl;
     }
 
+    {
+        char js[] = "{\"type\":\"a\",\"wire\":{\"type\":\"b\",\"list\":[{\"type\":\"c\"}]},\"ctrl\":false}";
+        const char* expected[] = { "a", "b", "c" };
+        const int16_t expected_depth[] = { 1, 2, 4 };
+
+        gjson::UserBuffer ubjio(js, sizeof(js), strlen(js));
+        gjson::JSONSimpleStringParseAttr<12> pr(&ubjio);
+        gjson::JSONSearchCursor c;
+        uint16_t found = 0;
+
+        std::cout << "Test: " << test++ << ", Find all attribute/property values by search cursor" << std::endl;
+        std::cout << "Input:  " << ubjio.Get() << std::endl;
+
+        // Node level checks remain enabled, nesting state is kept by cursor
+        while(pr.FromStringSearchNext(&c, "type")) {
+            std::cout << "Found: " << pr.GetAttrValue() << " span " << c.Start() << "-" << c.End() << " depth " << c.Depth() << std::endl;
+            if (found>=3 || strcmp(pr.GetAttrValue(), expected[found]) || c.Depth() != expected_depth[found] || 
+                    strncmp(&js[c.Start()], expected[found], c.End() - c.Start())) {
+                std::cout << "Test failed" << std::endl << std::endl;
+                return 1;
+            }
+            found++;
+        }
+        if (pr.GetLastError() != gjson::JSONConstant::ERR_NOT_FOUND || 3 != found) {
+            std::cout << "Last error: " << pr.GetLastError() << ", found " << found << std::endl;
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        std::cout << "Test passed" << std::endl << std::endl;
+    }
+
+    {
+        char js[] = "[100,200,[\"200\",{\"200\":200}],200]";
+
+        gjson::UserBuffer ubjio(js, sizeof(js), strlen(js));
+        JSONSimpleStringParse<8> pr(&ubjio);
+        gjson::JSONSearchCursor c;
+        uint16_t found = 0;
+
+        std::cout << "Test: " << test++ << ", Find all strings by search cursor" << std::endl;
+        std::cout << "Input: " << ubjio.Get() << std::endl;
+
+        while(pr.FromStringSearchNext(&c, "200")) {
+            std::cout << "Found at character index " << c.Start() << " depth " << c.Depth() << std::endl;
+            if (strncmp(&js[c.Start()], "200", 3)) {
+                std::cout << "Test failed" << std::endl << std::endl;
+                return 1;
+            }
+            found++;
+        }
+        if (pr.GetLastError() != JSONConstant::ERR_NOT_FOUND || 5 != found) {
+            std::cout << "Last error: " << pr.GetLastError() << ", found " << found << std::endl;
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        std::cout << "Test passed" << std::endl << std::endl;
+    }
+
+    {
+        char js[] = "{\"id\":\"a much longer value than LENGTH\",\"n\":-12.5,\"body\":{\"x\":[1,2],\"y\":\"z\"},\"end\":true}";
+
+        gjson::UserBuffer ubjio(js, sizeof(js), strlen(js));
+        gjson::JSONSimpleStringParseAttr<8> pr(&ubjio);
+
+        std::cout << "Test: " << test++ << ", Attribute/property key and value spans" << std::endl;
+        std::cout << "Input:  " << ubjio.Get() << std::endl;
+
+        // Quoted value, span includes quotes and is not truncated
+        pr.FromStringSearch("id");
+        if (pr.GetLastError() != gjson::JSONConstant::ERR_NONE || 
+                strncmp(&js[pr.GetValueSpan().Offset()], "\"a much longer value than LENGTH\"", pr.GetValueSpan().Length()) || 
+                strncmp(&js[pr.GetKeySpan().Offset()], "\"id\"", pr.GetKeySpan().Length())) {
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+
+        // Literal value
+        pr.FromStringSearch("n");
+        if (pr.GetLastError() != gjson::JSONConstant::ERR_NONE || 5 != pr.GetValueSpan().Length() || 
+                strncmp(&js[pr.GetValueSpan().Offset()], "-12.5", 5)) {
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+
+        // Map value, span runs to matching close
+        pr.FromStringSearchSpan("body");
+        if (pr.GetLastError() != gjson::JSONConstant::ERR_NONE || pr.GetAttrValue()[0] || 
+                strncmp(&js[pr.GetValueSpan().Offset()], "{\"x\":[1,2],\"y\":\"z\"}", pr.GetValueSpan().Length()) || 
+                19 != pr.GetValueSpan().Length()) {
+            std::cout << "Last error: " << pr.GetLastError() << std::endl;
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        std::cout << "Value of body: ";
+        std::cout.write(&js[pr.GetValueSpan().Offset()], pr.GetValueSpan().Length()) << std::endl;
+
+        // Plain search skips array or map values, continuing to next match
+        char js2[] = "{\"x\":[\"x\",1],\"m\":{\"x\":\"inner\"},\"y\":2}";
+        gjson::UserBuffer ubjio2(js2, sizeof(js2), strlen(js2));
+        gjson::JSONSimpleStringParseAttr<8> pr2(&ubjio2);
+
+        pr2.FromStringSearch("x");
+        if (pr2.GetLastError() != gjson::JSONConstant::ERR_NONE || strcmp(pr2.GetAttrValue(), "inner")) {
+            std::cout << "Last error: " << pr2.GetLastError() << std::endl;
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        pr2.FromStringSearch("m");
+        if (pr2.GetLastError() != gjson::JSONConstant::ERR_NOT_FOUND) {
+            std::cout << "Last error: " << pr2.GetLastError() << std::endl;
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        std::cout << "Test passed" << std::endl << std::endl;
+    }
+
+    {
+        char js[] = "{ \"a\" : { \"skip\":[1,{\"b\":\"]\"}], \"b\" : [ 0, \"x\", {}, { \"c\" : { \"d\":[true] } } ], \"a/b~\":-1 } }";
+        const char* pointers[] = { "/a/b/3/c", "/a/b/1", "/a/a~1b~0", "", "/a/b/4", "/a/b/01", "/a/c", "/a/b/65536", "/a/b/65539" };
+        const char* expected[] = { "{ \"d\":[true] }", "\"x\"", "-1", js, NULL, NULL, NULL, NULL, NULL };
+        uint8_t p;
+
+        gjson::UserBuffer ubjio(js, sizeof(js), strlen(js));
+        gjson::JSONPointer jp(&ubjio);
+
+        std::cout << "Test: " << test++ << ", JSON Pointer lookup" << std::endl;
+        std::cout << "Input:  " << ubjio.Get() << std::endl;
+
+        for(p=0; p<sizeof(pointers)/sizeof(pointers[0]); p++) {
+            bool found = jp.Find(pointers[p]);
+
+            std::cout << "Pointer \"" << pointers[p] << "\" ";
+            if (expected[p]) {
+                if (!found || strlen(expected[p]) != jp.GetSpan().Length() || 
+                        strncmp(&js[jp.GetSpan().Offset()], expected[p], jp.GetSpan().Length())) {
+                    std::cout << "Last error: " << jp.GetLastError() << std::endl;
+                    std::cout << "Test failed" << std::endl << std::endl;
+                    return 1;
+                }
+                std::cout << "found: ";
+                std::cout.write(&js[jp.GetSpan().Offset()], jp.GetSpan().Length()) << std::endl;
+            }else {
+                if (found || jp.GetLastError() != gjson::JSONConstant::ERR_NOT_FOUND) {
+                    std::cout << "Last error: " << jp.GetLastError() << std::endl;
+                    std::cout << "Test failed" << std::endl << std::endl;
+                    return 1;
+                }
+                std::cout << "not found" << std::endl;
+            }
+        }
+
+        // Escapes other than "~0" and "~1" refused, not matched as '~'
+        if (jp.Find("/a/a~2b~0") || jp.GetLastError() != gjson::JSONConstant::ERR_BAD_ATTRIBUTE || 
+                jp.Find("/a/a~1b~") || jp.GetLastError() != gjson::JSONConstant::ERR_BAD_ATTRIBUTE) {
+            std::cout << "Last error: " << jp.GetLastError() << std::endl;
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        std::cout << "Test passed" << std::endl << std::endl;
+    }
+
+    {
+        char js[] = "{\"devices\":[{\"id\":\"d1\",\"on\":true},{\"id\":\"d2\",\"sub\":{\"id\":\"d3\"}}],\"id\":\"root\"}";
+        const char* queries[] = { "$.devices[*].id", "$..id", "$.devices[1].sub", "$.devices[0].*" };
+        const char* expected[] = { "d1 d2 ", "d1 d2 d3 root ", "{ ", "d1 true " };
+        uint8_t q;
+
+        gjson::Buffer<128> jio;
+        gjson::JSONParse<8> pr(&jio, 1024);
+        gjson::JSONElement<8>* h = NULL;
+
+        std::cout << "Test: " << test++ << ", JSONPath query of object chain" << std::endl;
+        std::cout << "Input:  " << js << std::endl;
+
+        pr.FromString(js, &h);
+        if (pr.GetLastError() != gjson::JSONConstant::ERR_NONE) {
+            std::cout << "Last error: " << pr.GetLastError() << std::endl;
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        for(q=0; q<sizeof(queries)/sizeof(queries[0]); q++) {
+            gjson::JSONPath<8> jp(queries[q]);
+            gjson::JSONElement<8>* f;
+            char results[32] = "";
+
+            for(f = jp.Find(h); f; f = jp.FindNext()) {
+                if (gjson::JSONElement<8>::STRING == f->Type()) {
+                    strcat(results, reinterpret_cast<gjson::JSONString<8>*>(f)->Data());
+                    strcat(results, " ");
+                }else {
+                    strcat(results, (gjson::JSONElement<8>::MAP == f->Type()) ? "{ " : "[ ");
+                }
+            }
+            std::cout << "Query " << queries[q] << " matched: " << results << std::endl;
+            if (jp.GetLastError() != gjson::JSONConstant::ERR_NOT_FOUND || strcmp(results, expected[q])) {
+                std::cout << "Last error: " << jp.GetLastError() << std::endl;
+                std::cout << "Test failed" << std::endl << std::endl;
+                pr.Release(&h);
+                return 1;
+            }
+        }
+        pr.Release(&h);
+        std::cout << "Test passed" << std::endl << std::endl;
+    }
+
+    {
+        char js[] = "{\"bar\":{\"value\":12,\"boot\":true,\"name\":\"lamp\"},\"cfg\":{\"m\":-1.5,\"value\":99},\"list\":[{\"id\":4},{\"id\":5}]}";
+
+        struct Result {
+            int32_t value;
+            bool boot;
+            double m;
+            int32_t ids;
+            char name[8];
+
+            static bool Value(void* ctx, const int32_t v) { reinterpret_cast<Result*>(ctx)->value = v; return false; }
+            static bool Boot(void* ctx, const bool v) { reinterpret_cast<Result*>(ctx)->boot = v; return false; }
+            static bool M(void* ctx, const double v) { reinterpret_cast<Result*>(ctx)->m = v; return false; }
+            static bool Id(void* ctx, const int32_t v) { reinterpret_cast<Result*>(ctx)->ids += v; return false; }
+            static bool Name(void* ctx, const gjson::JSONString<8>* v) { strcpy(reinterpret_cast<Result*>(ctx)->name, v->Data()); return false; }
+        }r = { 0, false, 0.0, 0, "" };
+
+        gjson::UserBuffer ubjio(js, sizeof(js), strlen(js));
+        gjson::JSONDispatchParse<8> pr(&ubjio);
+
+        std::cout << "Test: " << test++ << ", Path dispatch of typed values" << std::endl;
+        std::cout << "Input:  " << ubjio.Get() << std::endl;
+
+        pr.On("/bar/value", &Result::Value, &r);
+        pr.On("/bar/boot", &Result::Boot, &r);
+        pr.On("/bar/name", &Result::Name, &r);
+        pr.On("/cfg/m", &Result::M, &r);
+        pr.On("/list/*/id", &Result::Id, &r);
+        pr.FromString();
+        std::cout << "value " << r.value << ", boot " << r.boot << ", name " << r.name << ", m " << r.m << ", ids " << r.ids << std::endl;
+        if (pr.GetLastError() != gjson::JSONConstant::ERR_NONE || 12 != r.value || !r.boot || strcmp(r.name, "lamp") || 
+                -1.5 != r.m || 9 != r.ids) {
+            std::cout << "Last error: " << pr.GetLastError() << std::endl;
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        std::cout << "Test passed" << std::endl << std::endl;
+    }
+
+    {
+        struct Cmd {
+            uint8_t value;
+            int16_t offset;
+            bool boot;
+            float m;
+            uint32_t serial;
+            char name[8];
+        };
+        static const gjson::JSONBindField cmd_fields[] = {
+            GJSON_BIND_FIELD(Cmd, value, "value"),
+            GJSON_BIND_FIELD(Cmd, offset, "offset"),
+            GJSON_BIND_FIELD(Cmd, boot, "boot"),
+            GJSON_BIND_FIELD(Cmd, m, "m"),
+            GJSON_BIND_FIELD(Cmd, serial, "serial"),
+            GJSON_BIND_FIELD(Cmd, name, "name"),
+        };
+        char js[128] = "{\"value\":200,\"skip\":{\"value\":1},\"offset\":-300,\"boot\":true,\"m\":-1.25,\"serial\":4000000000,\"name\":\"lamp\"}";
+        Cmd cmd = { 0, 0, false, 0.0f, 0, "" };
+
+        gjson::UserBuffer ubjio(js, sizeof(js), strlen(js));
+        gjson::JSONBind<12, Cmd> bind(&ubjio, cmd_fields);
+
+        std::cout << "Test: " << test++ << ", Struct binding decode and encode" << std::endl;
+        std::cout << "Input:  " << ubjio.Get() << std::endl;
+
+        bind.Decode(&cmd);
+        if (bind.GetLastError() != gjson::JSONConstant::ERR_NONE || 0x3f != bind.GetDecoded() || 200 != cmd.value || -300 != cmd.offset || 
+                !cmd.boot || -1.25f != cmd.m || 4000000000UL != cmd.serial || strcmp(cmd.name, "lamp")) {
+            std::cout << "Last error: " << bind.GetLastError() << std::endl;
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+
+        cmd.value = 7;
+        cmd.m = 0.5f;
+        if (!bind.Encode(&cmd) || strcmp(bind.Get(), "{\"value\":7,\"offset\":-300,\"boot\":true,\"m\":0.5,\"serial\":4000000000,\"name\":\"lamp\"}")) {
+            std::cout << "Output: " << bind.Get() << std::endl;
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        std::cout << "Output: " << bind.Get() << std::endl;
+
+        // Type mismatch
+        strcpy(js, "{\"boot\":3}");
+        ubjio.Length(strlen(js));
+        bind.Decode(&cmd);
+        if (bind.GetLastError() != gjson::JSONConstant::ERR_BAD_VALUE) {
+            std::cout << "Last error: " << bind.GetLastError() << std::endl;
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+
+        // Integers out of field range
+        strcpy(js, "{\"offset\":-32768,\"value\":300}");
+        ubjio.Length(strlen(js));
+        bind.Decode(&cmd);
+        if (bind.GetLastError() != gjson::JSONConstant::ERR_BAD_VALUE || -32768 != cmd.offset || 7 != cmd.value) {
+            std::cout << "Last error: " << bind.GetLastError() << std::endl;
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        strcpy(js, "{\"serial\":4294967296}");
+        ubjio.Length(strlen(js));
+        bind.Decode(&cmd);
+        if (bind.GetLastError() != gjson::JSONConstant::ERR_BAD_VALUE || 4000000000UL != cmd.serial) {
+            std::cout << "Last error: " << bind.GetLastError() << std::endl;
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+
+        // 8 Byte integers
+        struct Wide {
+            int64_t t;
+            uint64_t u;
+        };
+        static const gjson::JSONBindField wide_fields[] = {
+            GJSON_BIND_FIELD(Wide, t, "t"),
+            GJSON_BIND_FIELD(Wide, u, "u"),
+        };
+        Wide wide = { 0, 0 };
+        gjson::JSONBind<12, Wide> wbind(&ubjio, wide_fields);
+
+        strcpy(js, "{\"t\":-5,\"u\":5000000000}");
+        ubjio.Length(strlen(js));
+        wbind.Decode(&wide);
+        if (wbind.GetLastError() != gjson::JSONConstant::ERR_NONE || -5 != wide.t || 5000000000ULL != wide.u) {
+            std::cout << "Last error: " << wbind.GetLastError() << std::endl;
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        wide.t = INT64_MIN;
+        if (!wbind.Encode(&wide) || strcmp(wbind.Get(), "{\"t\":-9223372036854775808,\"u\":5000000000}")) {
+            std::cout << "Output: " << wbind.Get() << std::endl;
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        strcpy(js, "{\"u\":-1}");
+        ubjio.Length(strlen(js));
+        wbind.Decode(&wide);
+        if (wbind.GetLastError() != gjson::JSONConstant::ERR_BAD_VALUE || 5000000000ULL != wide.u) {
+            std::cout << "Last error: " << wbind.GetLastError() << std::endl;
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        std::cout << "Test passed" << std::endl << std::endl;
+    }
+
+    {
+        char js[128];
+        gjson::UserBuffer ubjio(js, sizeof(js), 0);
+        gjson::JSONWriter w(&ubjio, 3);
+
+        std::cout << "Test: " << test++ << ", Streaming writer" << std::endl;
+
+        w.BeginMap();
+        w.Key("id");
+        w.Value(12);
+        w.Key("t");
+        w.Value(-2.125);
+        w.Key("list");
+        w.BeginArray();
+        w.Value(true);
+        w.Null();
+        w.BeginMap();
+        w.EndMap();
+        w.Value("x");
+        w.Value(4000000000UL);
+        w.EndArray();
+        w.Key("n");
+        w.Value(-7L);
+        w.EndMap();
+        if (w.GetLastError() != gjson::JSONConstant::ERR_NONE || w.Depth() || 
+                strcmp(ubjio.Get(), "{\"id\":12,\"t\":-2.125,\"list\":[true,null,{},\"x\",4000000000],\"n\":-7}")) {
+            std::cout << "Last error: " << w.GetLastError() << std::endl;
+            std::cout << "Output: " << ubjio.Get() << std::endl;
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        std::cout << "Output: " << ubjio.Get() << std::endl;
+
+        // Misuse, value without attribute/property then mismatched close
+        w.Reset();
+        w.BeginMap();
+        if (w.Value(1) || w.GetLastError() != gjson::JSONConstant::ERR_BAD_VALUE) {
+            std::cout << "Last error: " << w.GetLastError() << std::endl;
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        w.Reset();
+        w.BeginArray();
+        if (w.EndMap() || w.GetLastError() != gjson::JSONConstant::ERR_UNEXPECTED_END_OF_MAP) {
+            std::cout << "Last error: " << w.GetLastError() << std::endl;
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+
+        // Full width long integers, decimals NaN, infinite or beyond 32 bit integer part refused
+        char e[48];
+
+        w.Reset();
+        w.BeginArray();
+        w.Value(LONG_MIN);
+        w.Value(ULONG_MAX);
+        w.EndArray();
+        snprintf(e, sizeof(e), "[%ld,%lu]", LONG_MIN, ULONG_MAX);
+        if (w.GetLastError() != gjson::JSONConstant::ERR_NONE || strcmp(ubjio.Get(), e)) {
+            std::cout << "Last error: " << w.GetLastError() << std::endl;
+            std::cout << "Output: " << ubjio.Get() << std::endl;
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        w.Reset();
+        w.BeginArray();
+        w.Value(static_cast<int64_t>(INT64_MIN));
+        w.Value(static_cast<uint64_t>(UINT64_MAX));
+        w.Value(-5LL);
+        w.EndArray();
+        if (w.GetLastError() != gjson::JSONConstant::ERR_NONE || strcmp(ubjio.Get(), "[-9223372036854775808,18446744073709551615,-5]")) {
+            std::cout << "Last error: " << w.GetLastError() << std::endl;
+            std::cout << "Output: " << ubjio.Get() << std::endl;
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        w.Reset();
+        if (!w.Value(4294967295.25) || strcmp(ubjio.Get(), "4294967295.25")) {
+            std::cout << "Last error: " << w.GetLastError() << std::endl;
+            std::cout << "Output: " << ubjio.Get() << std::endl;
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        w.Reset();
+        w.BeginArray();
+        if (w.Value(4294967296.0) || w.GetLastError() != gjson::JSONConstant::ERR_BAD_VALUE) {
+            std::cout << "Last error: " << w.GetLastError() << std::endl;
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        w.Reset();
+        w.BeginArray();
+        if (w.Value(std::numeric_limits<double>::quiet_NaN()) || w.GetLastError() != gjson::JSONConstant::ERR_BAD_VALUE) {
+            std::cout << "Last error: " << w.GetLastError() << std::endl;
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        std::cout << "Test passed" << std::endl << std::endl;
+    }
+
+    {
+        char js[128];
+        gjson::UserBuffer ubjio(js, sizeof(js), 0);
+        gjson::JSONTemplate<4> tpl("{\"id\":?,\"name\":\"?\",\"t\":?8,\"on\":?5}", 2);
+        char e[48];
+
+        std::cout << "Test: " << test++ << ", Precompiled template render and patch" << std::endl;
+
+        tpl.Set(0, 7);
+        tpl.Set(1, -21.5);
+        tpl.Set(2, true);
+        if (tpl.GetLastError() != gjson::JSONConstant::ERR_NONE || 3 != tpl.Slots() || !tpl.Render(&ubjio) || 
+                strcmp(ubjio.Get(), "{\"id\":7,\"name\":\"?\",\"t\":-21.5   ,\"on\":true }")) {
+            std::cout << "Last error: " << tpl.GetLastError() << std::endl;
+            std::cout << "Output: " << ubjio.Get() << std::endl;
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        std::cout << "Output: " << ubjio.Get() << std::endl;
+
+        // Variable width slot 0 precedes, patching not possible
+        tpl.Set(1, 3.25);
+        if (tpl.Patch(&ubjio) || tpl.GetLastError() != gjson::JSONConstant::ERR_BAD_VALUE) {
+            std::cout << "Last error: " << tpl.GetLastError() << std::endl;
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+
+        gjson::JSONTemplate<4> ftpl("[?6,?7]");
+
+        ftpl.Set(0, 100U);
+        ftpl.Set(1, "ab");
+        ftpl.Render(&ubjio);
+        ftpl.Set(0, -5L);
+        ftpl.SetNull(1);
+        if (!ftpl.Patch(&ubjio) || strcmp(ubjio.Get(), "[-5    ,null   ]")) {
+            std::cout << "Last error: " << ftpl.GetLastError() << std::endl;
+            std::cout << "Output: " << ubjio.Get() << std::endl;
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        std::cout << "Patched: " << ubjio.Get() << std::endl;
+
+        ftpl.Set(1, "too long");
+        if (ftpl.Patch(&ubjio) || ftpl.GetLastError() != gjson::JSONConstant::ERR_BAD_VALUE) {
+            std::cout << "Last error: " << ftpl.GetLastError() << std::endl;
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+
+        gjson::JSONTemplate<4> ltpl("[?,?]");
+
+        ltpl.Set(0, LONG_MIN);
+        ltpl.Set(1, ULONG_MAX);
+        snprintf(e, sizeof(e), "[%ld,%lu]", LONG_MIN, ULONG_MAX);
+        if (!ltpl.Render(&ubjio) || strcmp(ubjio.Get(), e)) {
+            std::cout << "Last error: " << ltpl.GetLastError() << std::endl;
+            std::cout << "Output: " << ubjio.Get() << std::endl;
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        ltpl.Set(1, -std::numeric_limits<double>::infinity());
+        if (ltpl.Render(&ubjio) || ltpl.GetLastError() != gjson::JSONConstant::ERR_BAD_VALUE) {
+            std::cout << "Last error: " << ltpl.GetLastError() << std::endl;
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        std::cout << "Test passed" << std::endl << std::endl;
+    }
+
+    {
+        char js[] = "{\"k\\\"ey\":\"a\\\\b\\n\\u00e9\\ud83d\\ude00\\/\",\"t\":\"tab\\there\"}";
+        Buffer<128> bjio;
+        JSONParse<16> pr(&bjio, 1024);
+        JSONElement<16>* a = NULL;
+
+        std::cout << "Test: " << test++ << ", String escape decode and encode" << std::endl;
+        std::cout << "Input:  " << js << std::endl;
+
+        pr.FromString(js, &a);
+        auto k = (a ? reinterpret_cast<JSONString<16>*>(a->Next()) : NULL);
+        auto v = (k ? reinterpret_cast<JSONString<16>*>(k->Next()) : NULL);
+        if (pr.GetLastError() != JSONConstant::ERR_NONE || !v || strcmp(k->Data(), "k\"ey") || 
+                strcmp(v->Data(), "a\\b\n\xc3\xa9\xf0\x9f\x98\x80/") || 11 != v->Length()) {
+            std::cout << "Last error: " << pr.GetLastError() << std::endl;
+            pr.Release(&a);
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+
+        pr.FromObject(a);
+        pr.Release(&a);
+        if (pr.GetLastError() != JSONConstant::ERR_NONE || 
+                strcmp(bjio.Get(), "{ \"k\\\"ey\":\"a\\\\b\\n\xc3\xa9\xf0\x9f\x98\x80/\", \"t\":\"tab\\there\" }")) {
+            std::cout << "Output: " << bjio.Get() << std::endl;
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        std::cout << "Output: " << bjio.Get() << std::endl;
+
+        // Lone surrogate and control character
+        char d[8];
+        uint16_t l = JSONSupport::Unescape(d, sizeof(d), "\\udc00x\\u0001", 13);
+        if (5 != l || memcmp(d, "\xef\xbf\xbdx\x01", 5)) {
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        bjio.Length(0);
+        bjio.AppendEscaped("\x01\x1f\"");
+        bjio.Append('\0');
+        if (strcmp(bjio.Get(), "\\u0001\\u001f\\\"")) {
+            std::cout << "Output: " << bjio.Get() << std::endl;
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        std::cout << "Test passed" << std::endl << std::endl;
+    }
+
+    {
+        char js[] = "{\"name\":\"caf\xc3\xa9 long enough for block scanning \xe2\x82\xac\",\"k\xf0\x9f\x98\x80\":\"\xed\x9f\xbf\"}";
+        char bad[][40] = { "[\"overlong \xc0\xaf\"]", "[\"surrogate \xed\xa0\x80\"]", "[\"cut \xe2\x82\"]", "[\"high \xf4\x90\x80\x80\"]" };
+        JSONParse<16> pr(&jio, 1024);
+
+        std::cout << "Test: " << test++ << ", UTF-8 validation while parsing" << std::endl;
+
+        pr.ValidateUTF8();
+        pr.FromString(js);
+        if (pr.GetLastError() != JSONConstant::ERR_NONE || !JSONSupport::IsUTF8(js, strlen(js))) {
+            std::cout << "Last error: " << pr.GetLastError() << std::endl;
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        for(uint8_t b=0; b<sizeof(bad)/sizeof(bad[0]); b++) {
+            uint16_t fci = pr.FromString(bad[b]);
+
+            std::cout << "Invalid " << static_cast<int>(b) << ", last error: " << pr.GetLastError() << " at character " << fci << std::endl;
+            if (pr.GetLastError() != JSONConstant::ERR_BAD_ENCODING || JSONSupport::IsUTF8(bad[b], strlen(bad[b]))) {
+                std::cout << "Test failed" << std::endl << std::endl;
+                return 1;
+            }
+        }
+
+        // Not validated by default
+        pr.ValidateUTF8(false);
+        pr.FromString(bad[0]);
+        if (pr.GetLastError() != JSONConstant::ERR_NONE) {
+            std::cout << "Last error: " << pr.GetLastError() << std::endl;
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        std::cout << "Test passed" << std::endl << std::endl;
+    }
+
+    {
+        char js[] = "{\"id\":12,\"list\":[true,\"a\\\"b\"]}";
+        char out[64];
+        UserSpan sio(out, sizeof(out));
+        JSONParse<12, void, UserSpan> pr(&sio, 1024);
+        JSONElement<12>* a = NULL;
+
+        std::cout << "Test: " << test++ << ", String to object and back with non-virtual I/O" << std::endl;
+        std::cout << "Input:  " << js << std::endl;
+
+        pr.FromString(js, &a);
+        pr.FromObject(a);
+        pr.Release(&a);
+        if (pr.GetLastError() != JSONConstant::ERR_NONE || strcmp(sio.Get(), "{ \"id\":12, \"list\":[ true, \"a\\\"b\" ] }")) {
+            std::cout << "Last error: " << pr.GetLastError() << std::endl;
+            std::cout << "Output: " << sio.Get() << std::endl;
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        std::cout << "Output: " << sio.Get() << std::endl;
+        std::cout << "Test passed" << std::endl << std::endl;
+    }
+
+    {
+        char js[] = "{\"a\":[1,\"x\",true],\"b\":{\"c\":null}}";
+        JSONParse<12> pr(&jio, 1024);
+        JSONElement<12>* a = NULL;
+
+        std::cout << "Test: " << test++ << ", String to object statistics" << std::endl;
+        std::cout << "Input:  " << js << std::endl;
+
+        pr.FromString(js, &a);
+        const JSONParseStats& st = pr.GetStats();
+        std::cout << "Tokens: " << st.Tokens() << " Allocations: " << st.allocations << " Bytes: " << st.bytes << " Depth: " << st.max_depth << std::endl;
+        if (pr.GetLastError() != JSONConstant::ERR_NONE || st.bytes != strlen(js) || st.tokens[JSONParseStats::TOKEN_ARRAY] != 2 || 
+            st.tokens[JSONParseStats::TOKEN_MAP] != 4 || st.tokens[JSONParseStats::TOKEN_ATTRIBUTE] != 3 || st.tokens[JSONParseStats::TOKEN_VALUE] != 1 || 
+            st.tokens[JSONParseStats::TOKEN_LITERAL] != 3 || st.allocations != 13 || st.max_depth != 2 || st.peak_object_bytes != pr.GetBinarySize()) {
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        pr.Release(&a);
+        std::cout << "Frees: " << st.frees << " Object bytes: " << st.object_bytes << std::endl;
+        if (st.frees != 13 || st.object_bytes != 0) {
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        std::cout << "Test passed" << std::endl << std::endl;
+    }
+
+    {
+        char js[] = "[{\"a\":1},{\"b\":\"c\"}]";
+        JSONParse<12> pr(&jio, 1024);
+        JSONElement<12>* a = NULL;
+
+        std::cout << "Test: " << test++ << ", Trace hooks" << std::endl;
+        std::cout << "Input:  " << js << std::endl;
+
+        trace_ops = 0;
+        pr.FromString(js, &a);
+        std::cout << "FromString elements: " << trace_count << std::endl;
+        if (pr.GetLastError() != JSONConstant::ERR_NONE || trace_ops != 1 || trace_count != 10) {
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        pr.FromObject(a);
+        std::cout << "FromObject elements: " << trace_count << std::endl;
+        if (trace_ops != 2 || trace_count != 10) {
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        pr.Release(&a);
+        std::cout << "Release elements: " << trace_count << std::endl;
+        if (trace_ops != 3 || trace_count != 10) {
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        std::cout << "Test passed" << std::endl << std::endl;
+    }
+
+    {
+        char js[] = "{ \"a\" : \"b\\\"c\", \"d\":[ true , null, -1.5e3 ], \"e\":{} }";
+        JSONParse<12> pr(&jio, 1024);
+        JSONElement<12>* a = NULL;
+        uint32_t n, sz;
+
+        std::cout << "Test: " << test++ << ", Estimate object chain size" << std::endl;
+        std::cout << "Input:  " << js << std::endl;
+
+        sz = pr.Estimate(js, &n);
+        std::cout << "Estimate: " << sz << " Bytes, " << n << " elements" << std::endl;
+        pr.FromString(js, &a);
+        std::cout << "Binary size: " << pr.GetBinarySize() << " Bytes, " << pr.GetStats().allocations << " elements" << std::endl;
+        pr.Release(&a);
+        if (pr.GetLastError() != JSONConstant::ERR_NONE || sz != pr.GetBinarySize() || n != pr.GetStats().allocations || n != 13) {
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        // From start index, line breaks are white space, limit above 64K
+        strcpy(js, "\"x\" [1,\r\n 2,\n 3]");
+        if (!pr.Estimate(js, &n, 4) || n != 5 || pr.MemoryLimit(100000) != 100000) {
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        strcpy(js, "[ \"open");
+        if (pr.Estimate(js) || pr.GetLastError() != JSONConstant::ERR_UNTERMINATED_STRING) {
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        // Packed numeric arrays sized as built
+        strcpy(js, "{\"a\":[1,2,3],\"b\":[1.5, 2],\"c\":[true]}");
+        pr.PackNumbers();
+        sz = pr.Estimate(js, &n);
+        pr.FromString(js, &a);
+        std::cout << "Packed estimate: " << sz << " Bytes, binary size " << pr.GetBinarySize() << " Bytes" << std::endl;
+        pr.Release(&a);
+        if (pr.GetLastError() != JSONConstant::ERR_NONE || sz != pr.GetBinarySize() || n != pr.GetStats().allocations || n != 10) {
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        std::cout << "Test passed" << std::endl << std::endl;
+    }
+
+    {
+        JSONArray<12> o;
+        JSONString<12> v("x", &o);
+        JSONArray<12> c(o);
+        JSONArray<12> d(false);
+
+        std::cout << "Test: " << test++ << ", Element copy keeps next element" << std::endl;
+        std::cout << "Element size: " << sizeof(JSONArray<12>) << " " << sizeof(JSONString<12>) << " Bytes" << std::endl;
+
+        d = o;
+        if (o.Next() != &v || c.Next() != &v || d.Next() != &v || !c.IsOpen() || !d.IsOpen() || JSONElement<12>::ARRAY != d.Type() || 
+            !v.IsValue() || v.IsValueLiteral()) {
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        std::cout << "Test passed" << std::endl << std::endl;
+    }
+
+#if GJSON_COMPACT_ELEMENTS && UINTPTR_MAX > 0xffffffffUL
+    {
+        JSONArray<12> o;
+        JSONString<12> v("x", &o);
+        JSONElement<12>* far = reinterpret_cast<JSONElement<12>*>(reinterpret_cast<uintptr_t>(&o) + 0x80000000UL);
+
+        std::cout << "Test: " << test++ << ", Compact link out of range" << std::endl;
+
+        if (o.Next() != &v || o.Next(far) || o.Next() || !o.Next(&v) || o.Next() != &v) {
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        std::cout << "Test passed" << std::endl << std::endl;
+    }
+#endif // GJSON_COMPACT_ELEMENTS && UINTPTR_MAX > 0xffffffffUL
+
+    {
+        char js[] = "[{\"id\":1,\"name\":\"a\"},{\"id\":2,\"name\":\"b\"},{\"id\":3,\"name\":\"c\"}]";
+        char check_js[128];
+        JSONInternBuffer<12, 8> it;
+        JSONParse<12> pr(&jio, 1024);
+        JSONElement<12>* a = NULL;
+        JSONString<12>* k;
+        uint32_t sz;
+
+        std::cout << "Test: " << test++ << ", Interned attribute/properties" << std::endl;
+        std::cout << "Input:  " << js << std::endl;
+
+        pr.FromString(js, &a);
+        pr.FromObject(a);
+        strcpy(check_js, pr.Get());
+        sz = pr.GetBinarySize();
+        pr.Release(&a);
+
+        pr.Intern(&it);
+        pr.FromString(js, &a);
+        std::cout << "Binary size: " << sz << " interned " << pr.GetBinarySize() << " Bytes, " << it.Count() << " strings" << std::endl;
+        if (pr.GetLastError() != JSONConstant::ERR_NONE || it.Count() != 2 || pr.GetBinarySize() >= sz) {
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        pr.FromObject(a);
+        std::cout << "Output: " << pr.Get() << std::endl;
+        if (strcmp(check_js, pr.Get())) {
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        k = pr.FindString(a, const_cast<char*>("NAME"), false);
+        if (!k || strcmp(k->Data(), "name") || !k->Next() || strcmp(reinterpret_cast<JSONString<12>*>(k->Next())->Data(), "a") || 
+            pr.FindString(a, const_cast<char*>("absent"), false)) {
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        pr.Release(&a);
+        std::cout << "Test passed" << std::endl << std::endl;
+    }
+
+    {
+        char js[] = "{\"w\":[1.5, -2.25, 300],\"i\":[1,2,-3],\"l\":[1,9000000000],\"m\":[1,\"x\"],\"e\":[],\"s\":\"v\"}";
+        char check_js[160];
+        JSONParse<12> pr(&jio, 1024);
+        JSONElement<12>* a = NULL;
+        JSONNumbers<12>* w;
+        uint32_t sz;
+
+        std::cout << "Test: " << test++ << ", Packed numeric arrays" << std::endl;
+        std::cout << "Input:  " << js << std::endl;
+
+        pr.FromString(js, &a);
+        pr.FromObject(a);
+        strcpy(check_js, pr.Get());
+        sz = pr.GetBinarySize();
+        pr.Release(&a);
+
+        pr.PackNumbers();
+        pr.FromString(js, &a);
+        std::cout << "Binary size: " << sz << " packed " << pr.GetBinarySize() << " Bytes" << std::endl;
+        if (pr.GetLastError() != JSONConstant::ERR_NONE || pr.GetBinarySize() >= sz) {
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        w = reinterpret_cast<JSONNumbers<12>*>(a->Next()->Next());
+        if (JSONElement<12>::NUMBERS != w->Type() || JSONNumbers<12>::DOUBLE != w->Kind() || w->Count() != 3 || w->Double()[1] != -2.25) {
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        w = reinterpret_cast<JSONNumbers<12>*>(w->Next()->Next());
+        if (JSONNumbers<12>::INT32 != w->Kind() || w->Int32()[2] != -3 || !w->Next() || 
+            JSONNumbers<12>::INT64 != reinterpret_cast<JSONNumbers<12>*>(w->Next()->Next())->Kind()) {
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        pr.FromObject(a);
+        std::cout << "Output: " << pr.Get() << std::endl;
+        pr.Release(&a);
+        if (strcmp(check_js, pr.Get())) {
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        std::cout << "Test passed" << std::endl << std::endl;
+    }
+
+    {
+        char js[160] = "[{\"ts\":100,\"v\":1.5,\"id\":\"a\"},{\"v\":-2,\"x\":[1,{\"ts\":9}],\"ts\":101},{\"ts\":102,\"id\":\"c\",\"v\":0.25}]";
+        int32_t ts[2];
+        float v[2];
+        char id[2][4];
+        gjson::JSONColumn columns[] = {
+            GJSON_COLUMN(ts, "ts"),
+            GJSON_COLUMN(v, "v"),
+            GJSON_COLUMN(id, "id"),
+        };
+
+        gjson::UserBuffer ubjio(js, sizeof(js), strlen(js));
+        gjson::JSONColumns<12> cols(&ubjio, columns);
+        uint16_t rows;
+
+        std::cout << "Test: " << test++ << ", Columnar extraction" << std::endl;
+        std::cout << "Input:  " << ubjio.Get() << std::endl;
+
+        rows = cols.Extract();
+        std::cout << "Rows: " << rows << " ts: " << ts[0] << "," << ts[1] << " v: " << v[0] << "," << v[1] << std::endl;
+        if (2 != rows || !cols.IsMore() || 100 != ts[0] || 101 != ts[1] || 1.5f != v[0] || -2.0f != v[1] || strcmp(id[0], "a") || id[1][0]) {
+            std::cout << "Last error: " << cols.GetLastError() << std::endl;
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        rows = cols.Extract();
+        std::cout << "Rows: " << rows << " ts: " << ts[0] << " v: " << v[0] << std::endl;
+        if (1 != rows || cols.IsMore() || cols.GetLastError() != gjson::JSONConstant::ERR_NONE || 102 != ts[0] || 0.25f != v[0] || strcmp(id[0], "c")) {
+            std::cout << "Last error: " << cols.GetLastError() << std::endl;
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+
+        // Type mismatch
+        strcpy(js, "[{\"ts\":\"now\"}]");
+        ubjio.Length(strlen(js));
+        cols.Extract();
+        if (cols.GetLastError() != gjson::JSONConstant::ERR_BAD_VALUE) {
+            std::cout << "Last error: " << cols.GetLastError() << std::endl;
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        std::cout << "Test passed" << std::endl << std::endl;
+    }
+
+    {
+        char js[] = "{\"config\":{\"port\":8080,\"name\":\"a\\\"b\"},\"list\":[1,{\"x\":true}],\"big\":[[1,2],[3,4],[5,6],[7,8]]}";
+        gjson::UserBuffer ubjio(js, sizeof(js), strlen(js));
+        gjson::JSONLazy<12, 16> doc(&ubjio);
+        gjson::JSONLazy<12, 16>::Node r, n;
+        gjson::JSONString<12> s;
+
+        std::cout << "Test: " << test++ << ", On demand document" << std::endl;
+        std::cout << "Input:  " << ubjio.Get() << std::endl;
+
+        r = doc.Root();
+        n = doc.Member(doc.Member(r, "config"), "port");
+        if (!doc.Value(n, &s) || strcmp(s.Data(), "8080") || !s.IsValueLiteral()) {
+            std::cout << "Last error: " << doc.GetLastError() << std::endl;
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        n = doc.Member(doc.Member(r, "config"), "name");
+        if (!doc.Value(n, &s) || strcmp(s.Data(), "a\"b") || !doc.Key(n, &s) || strcmp(s.Data(), "name")) {
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        n = doc.Member(doc.Element(doc.Member(r, "list"), 1), "x");
+        std::cout << "Nodes: " << doc.GetNodes() << std::endl;
+        if (!doc.Value(n, &s) || strcmp(s.Data(), "true") || 2 != doc.Count(doc.Member(r, "list")) || 9 != doc.GetNodes()) {
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+
+        // Subtree as object chain
+        {
+            gjson::JSONParse<12> pr(&ubjio, 512);
+            gjson::JSONElement<12>* h = NULL;
+
+            if (!doc.Materialize(doc.Member(r, "list"), &pr, &h) || NULL == h || gjson::JSONElement<12>::ARRAY != h->Type()) {
+                std::cout << "Last error: " << doc.GetLastError() << std::endl;
+                std::cout << "Test failed" << std::endl << std::endl;
+                return 1;
+            }
+            pr.Release(&h);
+        }
+
+        // Chained lookup of absent member
+        n = doc.Element(doc.Member(r, "absent"), 0);
+        if (gjson::JSONLazy<12, 16>::NONE != n || doc.GetLastError() != gjson::JSONConstant::ERR_NOT_FOUND) {
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+
+        // Failed lookup first does not stop navigation into children not yet indexed
+        r = doc.Root();
+        doc.Member(r, "missing");
+        n = doc.Member(doc.Member(r, "config"), "port");
+        if (gjson::JSONLazy<12, 16>::NONE == n || 2 != doc.Count(doc.Member(r, "list")) || doc.GetLastError() != gjson::JSONConstant::ERR_NONE) {
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        std::cout << "Test passed" << std::endl << std::endl;
+    }
+
+    {
+        const char cached[] = "{\"a\":[1,2],\"s\":\"x]\"}";
+        const char* check_js = "{ \"id\":7, \"payload\":{\"a\":[1,2],\"s\":\"x]\"} }";
+        const char* check_js2 = "[ 1, {\"b\":[2]}, 3 ]";
+        gjson::JSONParse<12> pr(&jio, 512);
+
+        std::cout << "Test: " << test++ << ", Raw passthrough" << std::endl;
+
+        gjson::JSONMap<12> a;
+        gjson::JSONMapTuple<12> b("id", "7", &a, true);
+        gjson::JSONMapTupleRaw<12> c("payload", cached, strlen(cached), &b);
+        gjson::JSONMap<12> d(&c, false);
+
+        pr.FromObject(&a);
+        std::cout << "Output: " << pr.Get() << std::endl;
+        if (pr.GetLastError() != gjson::JSONConstant::ERR_NONE || strcmp(check_js, pr.Get())) {
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+
+        // Fragments opening and closing a map, node level balances across them
+        gjson::JSONArray<12> e;
+        gjson::JSONRaw<12> f("1, {\"b\":[", &e);
+        gjson::JSONRaw<12> g("2]}", &f);
+        gjson::JSONString<12> h("3", &g, true, true);
+        gjson::JSONArray<12> i(&h, false);
+
+        pr.FromObject(&e);
+        std::cout << "Output: " << pr.Get() << std::endl;
+        if (pr.GetLastError() != gjson::JSONConstant::ERR_NONE || strcmp(check_js2, pr.Get()) || 1 != f.Arrays() || -1 != g.Maps()) {
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        std::cout << "Test passed" << std::endl << std::endl;
+    }
+
+    {
+        char js[] = "{ \"id\": 12, \"name\": \"dev\", \"list\": [ 1, 2, 3 ], \"cfg\": { \"a\": true } }";
+        const char* check_js = "{ \"id\": 12, \"name\":\"box\",\"list\": [ 1, 2, 3,4], \"cfg\": { \"a\":false} }";
+        const uint32_t object_memory = 13 * sizeof(gjson::JSONString<12>) + 2 * sizeof(gjson::JSONArray<12>) + 4 * sizeof(gjson::JSONMap<12>);
+        gjson::JSONParse<12> pr(&jio, object_memory);
+        gjson::JSONElement<12>* h = NULL;
+        gjson::JSONElement<12>* three;
+        gjson::JSONElement<12>* close;
+        gjson::JSONString<12>* four;
+
+        std::cout << "Test: " << test++ << ", Incremental object to string" << std::endl;
+        std::cout << "Input:  " << js << std::endl;
+
+        pr.FromString(js, &h);
+        pr.FromObjectIncremental(h, js);
+        if (pr.GetLastError() != gjson::JSONConstant::ERR_NONE || strcmp(js, pr.Get())) {
+            std::cout << "Output: " << pr.Get() << std::endl;
+            std::cout << "Test failed" << std::endl << std::endl;
+            pr.Release(&h);
+            return 1;
+        }
+
+        // Change values and insert one, unchanged runs copied from source
+        reinterpret_cast<gjson::JSONString<12>*>(h->Next()->Next()->Next()->Next())->Data("box");
+        reinterpret_cast<gjson::JSONString<12>*>(pr.FindString(h, const_cast<char*>("a"), false)->Next())->Boolean(false);
+        three = pr.FindString(h, const_cast<char*>("3"));
+        close = three->Next();
+        four = new gjson::JSONString<12>("4", three, true, true);    // Released with object chain
+        four->Next(close);
+
+        pr.FromObjectIncremental(h, js);
+        std::cout << "Output: " << pr.Get() << std::endl;
+        pr.Release(&h);
+        if (pr.GetLastError() != gjson::JSONConstant::ERR_NONE || strcmp(check_js, pr.Get())) {
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+
+        // Object chain truncated by memory limit
+        pr.MemoryLimit(object_memory / 2);
+        pr.FromString(js, &h);
+        if (pr.GetLastError() != gjson::JSONConstant::ERR_OBJECT_MEMORY_LIMIT || pr.FromObjectIncremental(h, js) || *pr.Get()) {
+            std::cout << "Last error: " << pr.GetLastError() << std::endl;
+            std::cout << "Test failed" << std::endl << std::endl;
+            pr.Release(&h);
+            return 1;
+        }
+        pr.Release(&h);
+        std::cout << "Test passed" << std::endl << std::endl;
+    }
+
+    {
+        char js[] = "{\"a\":1,\"list\":[1,2,3],\"m\":{\"x\":true}}";
+        const char* check_js = "{ \"a\":1, \"list\":[ 1, 9, 3 ], \"z\":\"q\" }";
+        gjson::JSONParse<12> pr(&jio, 512);
+        gjson::JSONNodePool<12> pool;
+        gjson::JSONElement<12>* h = NULL;
+        gjson::JSONCursor<12> c(&h, &pool);
+
+        std::cout << "Test: " << test++ << ", Object chain edit" << std::endl;
+        std::cout << "Input:  " << js << std::endl;
+
+        pr.FromString(js, &h);
+        c.Reset();
+        if (!c.Member("list") || !c.Next() || !c.Element(1) || !c.Remove() || !c.InsertValue("9", true) || 0 != pool.GetFree()) {
+            std::cout << "Last error: " << c.GetLastError() << std::endl;
+            std::cout << "Test failed" << std::endl << std::endl;
+            pr.Release(&h);
+            return 1;
+        }
+        c.Reset();
+        if (!c.Member("m") || !c.Remove() || 5 != pool.GetFree() || c.Member("absent")) {
+            std::cout << "Last error: " << c.GetLastError() << std::endl;
+            std::cout << "Test failed" << std::endl << std::endl;
+            pr.Release(&h);
+            return 1;
+        }
+        c.Reset();
+        if (!c.End() || !c.InsertMember("z", "q") || 3 != pool.GetFree()) {
+            std::cout << "Last error: " << c.GetLastError() << std::endl;
+            std::cout << "Test failed" << std::endl << std::endl;
+            pr.Release(&h);
+            return 1;
+        }
+
+        pr.FromObject(h);
+        std::cout << "Output: " << pr.Get() << std::endl;
+        if (strcmp(check_js, pr.Get())) {
+            std::cout << "Test failed" << std::endl << std::endl;
+            pr.Release(&h);
+            return 1;
+        }
+
+        // Elements kept for reuse
+        pool.ReleaseChain(&h);
+        if (NULL != h || 15 != pool.GetFree()) {
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        std::cout << "Test passed" << std::endl << std::endl;
+    }
+
+    {
+        char js1[] = "{\"id\":7,\"v\":[1,\"x\"],\"m\":{}}";
+        char js2[] = "{\"id\":8,\"v\":[22,\"yz\"],\"m\":{}}";
+        const char* check_js = "{ \"id\":8, \"v\":[ 22, \"yz\" ], \"m\":{  } }";
+        gjson::JSONParse<12> pr(&jio, 512);
+        gjson::JSONNodePool<12> pool;
+        gjson::JSONElement<12>* h = NULL;
+
+        std::cout << "Test: " << test++ << ", Parse with element pool" << std::endl;
+        std::cout << "Input:  " << js1 << std::endl;
+        std::cout << "Input:  " << js2 << std::endl;
+
+        pr.Pool(&pool);
+        pr.FromString(js1, &h);
+        pr.Release(&h);
+        if (pr.GetLastError() != gjson::JSONConstant::ERR_NONE || 12 != pool.GetFree()) {
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+
+        // Alike message takes every element from pool
+        pr.FromString(js2, &h);
+        if (pr.GetLastError() != gjson::JSONConstant::ERR_NONE || 0 != pool.GetFree()) {
+            std::cout << "Test failed" << std::endl << std::endl;
+            pr.Release(&h);
+            return 1;
+        }
+        pr.FromObject(h);
+        std::cout << "Output: " << pr.Get() << std::endl;
+        pr.Release(&h);
+        if (strcmp(check_js, pr.Get()) || 12 != pool.GetFree()) {
+            std::cout << "Test failed" << std::endl << std::endl;
+            return 1;
+        }
+        std::cout << "Test passed" << std::endl << std::endl;
+    }
+
     return 0;
 } // _tmain(...)
@@ -16,6 +16,8 @@
 
 #include <cstdlib>
 #include <cstdint>
+#include <climits>
+#include <limits>
 #include <iostream>
 #include <iomanip>
 #include <new>          // std::nothrow